@@ -0,0 +1,117 @@
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include "Dictionary.h"
+
+/**
+ * Every word in the dictionary as X(word, rank), where a lower rank is a more likely word. The
+ * words must be kept in strcmp() order for the binary search to work.
+ */
+#define DICTIONARY_WORDS(X) \
+    X("599", 7) \
+    X("5NN", 8) \
+    X("73", 3) \
+    X("88", 43) \
+    X("ABOUT", 56) \
+    X("AGN", 17) \
+    X("AND", 25) \
+    X("ANT", 23) \
+    X("ARE", 51) \
+    X("BK", 18) \
+    X("BUT", 53) \
+    X("CPY", 34) \
+    X("CQ", 1) \
+    X("CUL", 29) \
+    X("DE", 2) \
+    X("ES", 12) \
+    X("FB", 13) \
+    X("FOR", 45) \
+    X("FROM", 49) \
+    X("GA", 31) \
+    X("GE", 32) \
+    X("GM", 30) \
+    X("HAVE", 48) \
+    X("HELLO", 54) \
+    X("HERE", 55) \
+    X("HR", 11) \
+    X("HW", 28) \
+    X("MESSAGE", 63) \
+    X("NAME", 9) \
+    X("NOT", 52) \
+    X("OM", 14) \
+    X("PLEASE", 57) \
+    X("POWER", 64) \
+    X("PSE", 16) \
+    X("QRM", 35) \
+    X("QRN", 36) \
+    X("QRP", 38) \
+    X("QRQ", 40) \
+    X("QRS", 39) \
+    X("QRZ", 27) \
+    X("QSB", 37) \
+    X("QSL", 19) \
+    X("QSO", 20) \
+    X("QSY", 41) \
+    X("QTH", 10) \
+    X("RADIO", 59) \
+    X("REPORT", 61) \
+    X("RIG", 22) \
+    X("RST", 6) \
+    X("SIGNAL", 60) \
+    X("SRI", 33) \
+    X("THANKS", 58) \
+    X("THAT", 44) \
+    X("THE", 24) \
+    X("THIS", 47) \
+    X("TNX", 4) \
+    X("TU", 15) \
+    X("UR", 5) \
+    X("WEATHER", 62) \
+    X("WITH", 46) \
+    X("WKD", 42) \
+    X("WX", 21) \
+    X("YOU", 26) \
+    X("YOUR", 50)
+
+typedef struct {
+    const char *word;
+    uint8_t rank;
+} DictionaryEntry;
+
+#define DICTIONARY_ENTRY(word, rank) { word, rank },
+static const DictionaryEntry words[] = {
+    DICTIONARY_WORDS(DICTIONARY_ENTRY)
+};
+
+#define DICTIONARY_SIZE ((int) (sizeof (words) / sizeof (words[0])))
+
+// Every word must fit within DICTIONARY_MAX_WORD_LENGTH.
+#define DICTIONARY_WORD_TOO_LONG(word, rank) || (sizeof (word) - 1 > DICTIONARY_MAX_WORD_LENGTH)
+typedef char DictionaryCheckLengths[(0 DICTIONARY_WORDS(DICTIONARY_WORD_TOO_LONG)) ? -1 : 1];
+
+const char *DictionaryComplete(const char *prefix, int length)
+{
+    const DictionaryEntry *best = NULL;
+    int low = 0;
+    int high = DICTIONARY_SIZE;
+
+    if (length < 1) {
+        return NULL;
+    }
+
+    // Find the first word that doesn't sort before the prefix; all words starting with it follow.
+    while (low < high) {
+        int middle = (low + high) / 2;
+        if (strncmp(words[middle].word, prefix, length) < 0) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    for (; low < DICTIONARY_SIZE && strncmp(words[low].word, prefix, length) == 0; ++low) {
+        if (words[low].word[length] != '\0' && (best == NULL || words[low].rank < best->rank)) {
+            best = &words[low];
+        }
+    }
+    return best != NULL ? best->word : NULL;
+}
@@ -0,0 +1,30 @@
+#ifndef DICTIONARY_H
+#define DICTIONARY_H
+
+/**
+ * @file
+ *
+ * This library suggests how a partly keyed word might end, from a `const` list of common words and
+ * the usual CW abbreviations and Q-codes stored in flash. The list is kept
+ * sorted, so all words starting with a prefix sit next to each other and are found with a binary
+ * search. Each word also has a rank, and the best-ranked of those words is the one suggested.
+ *
+ * Example usage after each decoded letter:
+ * const char *word = DictionaryComplete("QT", 2);
+ * if (word != NULL) {
+ *     // word is "QTH".
+ * }
+ */
+
+// The length of the longest word in the dictionary.
+#define DICTIONARY_MAX_WORD_LENGTH 7
+
+/**
+ * Finds the most likely word that starts with a prefix and is longer than it.
+ * @param prefix The start of the word, in uppercase. Doesn't have to be null-terminated.
+ * @param length How many chars of `prefix` to use.
+ * @return The word, which stays valid forever, or NULL if no word starts with `prefix`.
+ */
+const char *DictionaryComplete(const char *prefix, int length);
+
+#endif // DICTIONARY_H
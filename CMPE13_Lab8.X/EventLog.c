@@ -0,0 +1,93 @@
+#include <stdint.h>
+#include <string.h>
+#include "EventLog.h"
+#include "BOARD.h"
+
+// The header is the magic without its '\0', followed by the version.
+typedef char EventLogCheckHeader[(sizeof (EVENT_LOG_MAGIC) == EVENT_LOG_HEADER_SIZE) ? 1 : -1];
+
+// Each varint byte holds 7 bits of the value, and its top bit says whether another byte follows.
+#define EVENT_LOG_VARINT_BITS 7
+#define EVENT_LOG_VARINT_MORE 0x80
+#define EVENT_LOG_VARINT_MAX_BYTES (EVENT_LOG_MAX_RECORD_SIZE - 1)
+
+int EventLogRecorderInit(EventLogRecorder *recorder, EventLogSink sink, uint32_t time)
+{
+    uint8_t header[EVENT_LOG_HEADER_SIZE];
+    memcpy(header, EVENT_LOG_MAGIC, EVENT_LOG_HEADER_SIZE - 1);
+    header[EVENT_LOG_HEADER_SIZE - 1] = EVENT_LOG_VERSION;
+    recorder->sink = sink;
+    recorder->lastTime = time;
+    recorder->drops = 0;
+    return sink(header, sizeof (header));
+}
+
+void EventLogRecordEdge(EventLogRecorder *recorder, uint8_t channel, uint32_t time, int pressed)
+{
+    uint8_t record[EVENT_LOG_MAX_RECORD_SIZE];
+    EventLogEdge edge;
+    int size;
+
+    edge.delta = time - recorder->lastTime;
+    edge.channel = channel;
+    edge.pressed = pressed ? TRUE : FALSE;
+    size = EventLogEncode(&edge, record);
+    if (recorder->sink(record, size) == SUCCESS) {
+        recorder->lastTime = time;
+    } else {
+        // Keep measuring from the previous record that made it, so the next one still lands at
+        // the right time.
+        recorder->drops++;
+    }
+}
+
+int EventLogEncode(const EventLogEdge *edge, uint8_t *record)
+{
+    uint32_t delta = edge->delta;
+    int size = 0;
+    record[size++] = edge->channel | (edge->pressed ? EVENT_LOG_PRESSED : 0);
+    while (delta >= EVENT_LOG_VARINT_MORE) {
+        record[size++] = (delta & (EVENT_LOG_VARINT_MORE - 1)) | EVENT_LOG_VARINT_MORE;
+        delta >>= EVENT_LOG_VARINT_BITS;
+    }
+    record[size++] = delta;
+    return size;
+}
+
+int EventLogReaderInit(EventLogReader *reader, const uint8_t *data, int size)
+{
+    if (size < EVENT_LOG_HEADER_SIZE ||
+            memcmp(data, EVENT_LOG_MAGIC, EVENT_LOG_HEADER_SIZE - 1) != 0 ||
+            data[EVENT_LOG_HEADER_SIZE - 1] != EVENT_LOG_VERSION) {
+        return STANDARD_ERROR;
+    }
+    reader->data = data;
+    reader->size = size;
+    reader->position = EVENT_LOG_HEADER_SIZE;
+    return SUCCESS;
+}
+
+int EventLogReadEdge(EventLogReader *reader, EventLogEdge *edge)
+{
+    uint32_t delta = 0;
+    int shift = 0;
+    uint8_t byte;
+
+    if (reader->position == reader->size) {
+        return STANDARD_ERROR;
+    }
+    byte = reader->data[reader->position++];
+    edge->channel = byte & ~EVENT_LOG_PRESSED;
+    edge->pressed = (byte & EVENT_LOG_PRESSED) ? TRUE : FALSE;
+    do {
+        if (reader->position == reader->size ||
+                shift == EVENT_LOG_VARINT_BITS * EVENT_LOG_VARINT_MAX_BYTES) {
+            return SIZE_ERROR;
+        }
+        byte = reader->data[reader->position++];
+        delta |= (uint32_t) (byte & (EVENT_LOG_VARINT_MORE - 1)) << shift;
+        shift += EVENT_LOG_VARINT_BITS;
+    } while (byte & EVENT_LOG_VARINT_MORE);
+    edge->delta = delta;
+    return SUCCESS;
+}
@@ -0,0 +1,137 @@
+#ifndef EVENT_LOG_H
+#define EVENT_LOG_H
+
+/**
+ * @file
+ *
+ * This library records the key edges timestamped by KeyCapture.h and plays them back edge by edge.
+ * A log of real keying can then be fed back through a KeyCaptureKeyer and its MorseTiming to
+ * reproduce exactly what the decoder saw, with the same microsecond timing, as fast as it can run,
+ * including on the host build.
+ *
+ * A log starts with the EVENT_LOG_HEADER_SIZE byte header: EVENT_LOG_MAGIC followed by
+ * EVENT_LOG_VERSION. After that, every edge is stored as a record of:
+ *   * The channel it was on, with EVENT_LOG_PRESSED set if the key went down, as one byte.
+ *   * How many core timer counts it came after the previous record, or after recording started
+ *     for the first one, as an unsigned LEB128 varint: 7 bits per byte, least significant first,
+ *     with the top bit set on every byte but the last. The core timer counts at 40MHz, so gaps
+ *     under 6.7s take at most 4 bytes.
+ * The delta is taken modulo 2^32, just like the core timer itself, so a gap of more than about
+ * 107s comes out short by a multiple of that. Such a gap ends any word anyway.
+ *
+ * Records are handed to a sink, such as UartWrite(), which streams them out as they happen. A
+ * record the sink can't take is dropped whole, and its delta is added to the next one, so the rest
+ * of the log keeps its timing.
+ *
+ * Example usage for recording over the serial port:
+ * static EventLogRecorder recorder;
+ * EventLogRecorderInit(&recorder, UartWrite, ReadCoreTimer());
+ * KeyCaptureSetRecorder(&recorder);
+ *
+ * Example usage for replaying a log:
+ * EventLogReader reader;
+ * EventLogEdge edge;
+ * EventLogReaderInit(&reader, log, logSize);
+ * while (EventLogReadEdge(&reader, &edge) == SUCCESS) {
+ *     time += edge.delta;
+ *     ...
+ * }
+ */
+
+#include <stdint.h>
+
+// The bytes every log starts with, and the version of the format that follows them.
+#define EVENT_LOG_MAGIC "MLG"
+#define EVENT_LOG_VERSION 2
+#define EVENT_LOG_HEADER_SIZE 4
+
+// The first byte of a record holds the channel in its low bits and this flag for a key-down edge.
+#define EVENT_LOG_PRESSED 0x80
+
+// The most bytes a single record can take: a 32-bit delta needs 5 varint bytes.
+#define EVENT_LOG_MAX_RECORD_SIZE 6
+
+/**
+ * A function that takes bytes of a log, such as UartWrite().
+ * @param data The bytes to write.
+ * @param size How many bytes to write.
+ * @return SUCCESS or STANDARD_ERROR if none of them were taken.
+ */
+typedef int (*EventLogSink)(const uint8_t *data, int size);
+
+/**
+ * A single edge of a log: how many core timer counts it came after the previous one, which
+ * KeyCapture.h channel it was on and whether the key went down (TRUE) or up (FALSE).
+ */
+typedef struct {
+    uint32_t delta;
+    uint8_t channel;
+    uint8_t pressed;
+} EventLogEdge;
+
+/**
+ * An EventLogRecorder holds the state for writing one log. Its members should be treated as
+ * private except for `drops`, which counts every record that the sink couldn't take.
+ */
+typedef struct {
+    EventLogSink sink;
+    uint32_t lastTime;
+    uint32_t drops;
+} EventLogRecorder;
+
+/**
+ * An EventLogReader holds the state for playing back one log. Its members should be treated as
+ * private.
+ */
+typedef struct {
+    const uint8_t *data;
+    int size;
+    int position;
+} EventLogReader;
+
+/**
+ * Starts a new log by writing its header to the sink.
+ * @param recorder The recorder to initialize.
+ * @param sink Where the log is written.
+ * @param time The core timer when recording starts, which the first delta is measured from.
+ * @return SUCCESS or STANDARD_ERROR if the sink didn't take the header.
+ */
+int EventLogRecorderInit(EventLogRecorder *recorder, EventLogSink sink, uint32_t time);
+
+/**
+ * Records one edge. Edges must be recorded in the order they were timestamped.
+ * @param recorder The recorder to write to.
+ * @param channel The channel of the edge.
+ * @param time When the edge happened, read with ReadCoreTimer().
+ * @param pressed TRUE if the key went down, FALSE if it went up.
+ */
+void EventLogRecordEdge(EventLogRecorder *recorder, uint8_t channel, uint32_t time, int pressed);
+
+/**
+ * Encodes a single record.
+ * @param edge The edge to encode.
+ * @param record Where the record is stored, at least EVENT_LOG_MAX_RECORD_SIZE bytes.
+ * @return How many bytes of `record` were used.
+ */
+int EventLogEncode(const EventLogEdge *edge, uint8_t *record);
+
+/**
+ * Starts playing back a log.
+ * @param reader The reader to initialize.
+ * @param data The log, starting with its header. It must stay valid while the reader is used.
+ * @param size How many bytes of the log there are.
+ * @return SUCCESS or STANDARD_ERROR if `data` doesn't start with a header of this version.
+ */
+int EventLogReaderInit(EventLogReader *reader, const uint8_t *data, int size);
+
+/**
+ * Plays back the next edge of a log.
+ * @param reader The reader to read from.
+ * @param edge Where the edge is stored.
+ * @return SUCCESS, STANDARD_ERROR once every edge has been read, or SIZE_ERROR if the log ends in
+ *         the middle of a record or has a delta longer than 32 bits, neither of which the recorder
+ *         ever writes.
+ */
+int EventLogReadEdge(EventLogReader *reader, EventLogEdge *edge);
+
+#endif // EVENT_LOG_H
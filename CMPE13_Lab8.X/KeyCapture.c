@@ -0,0 +1,265 @@
+#include <stdint.h>
+#include <stddef.h>
+#include "KeyCapture.h"
+#include "Trace.h"
+#include "BOARD.h"
+
+// Microchip libraries
+#include <xc.h>
+#include <plib.h>
+
+// BTN2-BTN4 are on change-notice pins CN14-CN16, in the same order as their MorseChannels.
+#define KEY_CAPTURE_FIRST_CHANNEL MORSE_CHANNEL_BTN2
+#define KEY_CAPTURE_FIRST_CN 14
+#define KEY_CAPTURE_CN_BIT(channel) \
+    (1 << (KEY_CAPTURE_FIRST_CN + (channel) - KEY_CAPTURE_FIRST_CHANNEL))
+#define KEY_CAPTURE_CN_ON (1 << 15)
+
+// Converts the fixed MorseEventLengths, which are in 100Hz ticks, to microseconds.
+#define KEY_CAPTURE_FROM_MORSE_TICKS(ticks) \
+    ((ticks) * (KEY_CAPTURE_TICKS_PER_SECOND / MORSE_TICKS_PER_SECOND))
+
+typedef char KeyCaptureCheckQueueSize[
+    ((KEY_CAPTURE_EDGE_QUEUE_SIZE & (KEY_CAPTURE_EDGE_QUEUE_SIZE - 1)) == 0) ? 1 : -1];
+
+// A single timestamped change of a button, in core timer counts.
+typedef struct {
+    uint32_t time;
+    uint8_t pressed;
+} KeyCaptureEdge;
+
+// One queue of edges per channel, written only by the interrupts and read only by
+// KeyCaptureCheckEvents(), along with the last edge accepted for each channel.
+static KeyCaptureEdge edges[KEY_CAPTURE_NUM_CHANNELS][KEY_CAPTURE_EDGE_QUEUE_SIZE];
+static volatile uint32_t heads[KEY_CAPTURE_NUM_CHANNELS];
+static volatile uint32_t tails[KEY_CAPTURE_NUM_CHANNELS];
+static volatile uint32_t lastTimes[KEY_CAPTURE_NUM_CHANNELS];
+static volatile uint8_t lastStates;
+static volatile uint32_t overflows;
+static KeyCaptureCallback edgeCallback;
+static EventLogRecorder * volatile edgeRecorder;
+
+// Core timer counts per microsecond, and the hold-off converted to counts.
+static uint32_t countsPerUs;
+static uint32_t holdoffCounts;
+
+static void KeyCapturePut(MorseChannel channel, uint32_t time, uint8_t pressed);
+static void KeyCaptureResync(MorseChannel channel);
+static MorseEvent KeyCaptureTraceEvent(MorseChannel channel, MorseEvent event);
+static uint32_t KeyCaptureElapsed(uint32_t from, uint32_t to);
+
+void KeyCaptureInit(KeyCaptureCallback callback)
+{
+    int channel;
+
+    // The core timer counts at half the system clock.
+    countsPerUs = BOARD_GetSysClock() / 2 / KEY_CAPTURE_TICKS_PER_SECOND;
+    holdoffCounts = KEY_CAPTURE_HOLDOFF_US * countsPerUs;
+
+    INTEnable(INT_CN, INT_DISABLED);
+    lastStates = BUTTON_STATES();
+    for (channel = 0; channel < KEY_CAPTURE_NUM_CHANNELS; ++channel) {
+        heads[channel] = 0;
+        tails[channel] = 0;
+        lastTimes[channel] = ReadCoreTimer() - holdoffCounts;
+    }
+    overflows = 0;
+    edgeCallback = callback;
+
+    CNCONSET = KEY_CAPTURE_CN_ON;
+    CNENSET = KEY_CAPTURE_CN_BIT(MORSE_CHANNEL_BTN2) | KEY_CAPTURE_CN_BIT(MORSE_CHANNEL_BTN3) |
+            KEY_CAPTURE_CN_BIT(MORSE_CHANNEL_BTN4);
+
+    // Reading the port sets the state the next change is compared against. Use a priority above the
+    // 100Hz timer so that an edge is timestamped as soon as it happens.
+    (void) PORTD;
+    INTClearFlag(INT_CN);
+    INTSetVectorPriority(INT_CHANGE_NOTICE_VECTOR, INT_PRIORITY_LEVEL_5);
+    INTSetVectorSubPriority(INT_CHANGE_NOTICE_VECTOR, INT_SUB_PRIORITY_LEVEL_0);
+    INTEnable(INT_CN, INT_ENABLED);
+}
+
+void KeyCaptureSetRecorder(EventLogRecorder *recorder)
+{
+    edgeRecorder = recorder;
+}
+
+int KeyCaptureKeyerInit(KeyCaptureKeyer *keyer, MorseChannel channel)
+{
+    if (channel < KEY_CAPTURE_FIRST_CHANNEL || channel > KEY_CAPTURE_CHANNEL_TONE) {
+        return STANDARD_ERROR;
+    }
+    keyer->channel = channel;
+    keyer->state = KEY_CAPTURE_STATE_IDLE;
+    keyer->edgeTime = 0;
+    keyer->timing = NULL;
+    tails[channel] = heads[channel];
+    return SUCCESS;
+}
+
+void KeyCaptureKeyerSetTiming(KeyCaptureKeyer *keyer, MorseTiming *timing)
+{
+    keyer->timing = timing;
+}
+
+MorseEvent KeyCaptureCheckEvents(KeyCaptureKeyer *keyer)
+{
+    MorseChannel channel = keyer->channel;
+    uint32_t dashLength = KEY_CAPTURE_FROM_MORSE_TICKS(MORSE_EVENT_LENGTH_DOWN_DASH);
+    uint32_t letterLength = KEY_CAPTURE_FROM_MORSE_TICKS(MORSE_EVENT_LENGTH_UP_INTER_LETTER);
+    uint32_t wordLength = KEY_CAPTURE_FROM_MORSE_TICKS(MORSE_EVENT_LENGTH_UP_INTER_WORD);
+
+    if (keyer->timing != NULL) {
+        dashLength = keyer->timing->dashThreshold;
+        letterLength = keyer->timing->letterThreshold;
+        wordLength = keyer->timing->wordThreshold;
+    }
+    KeyCaptureResync(channel);
+
+    while (1) {
+        // Gaps are measured up to the next queued edge if there is one, since the key stayed up
+        // until then no matter how late that edge is being handled. The time is read first so
+        // that any edge queued after it is seen as pending.
+        uint32_t now = ReadCoreTimer();
+        int pending = tails[channel] != heads[channel];
+        KeyCaptureEdge edge = edges[channel][tails[channel] & (KEY_CAPTURE_EDGE_QUEUE_SIZE - 1)];
+        uint32_t gapEnd = pending ? edge.time : now;
+        uint32_t gap = KeyCaptureElapsed(keyer->edgeTime, gapEnd);
+
+        if (keyer->state == KEY_CAPTURE_STATE_ELEMENT_GAP && gap >= letterLength) {
+            keyer->state = KEY_CAPTURE_STATE_LETTER_GAP;
+            return KeyCaptureTraceEvent(channel, MORSE_EVENT_INTER_LETTER);
+        }
+        if (keyer->state == KEY_CAPTURE_STATE_LETTER_GAP && gap >= wordLength) {
+            keyer->state = KEY_CAPTURE_STATE_IDLE;
+            return KeyCaptureTraceEvent(channel, MORSE_EVENT_INTER_WORD);
+        }
+        if (!pending) {
+            return MORSE_EVENT_NONE;
+        }
+        tails[channel]++;
+
+        if (edge.pressed) {
+            if (keyer->state != KEY_CAPTURE_STATE_DOWN) {
+                keyer->edgeTime = edge.time;
+                keyer->state = KEY_CAPTURE_STATE_DOWN;
+            }
+        } else if (keyer->state == KEY_CAPTURE_STATE_DOWN) {
+            uint32_t length = KeyCaptureElapsed(keyer->edgeTime, edge.time);
+            keyer->edgeTime = edge.time;
+            keyer->state = KEY_CAPTURE_STATE_ELEMENT_GAP;
+            if (keyer->timing != NULL) {
+                MorseTimingAddPress(keyer->timing, length);
+            }
+            return KeyCaptureTraceEvent(channel,
+                    (length > dashLength) ? MORSE_EVENT_DASH : MORSE_EVENT_DOT);
+        }
+    }
+}
+
+int KeyCaptureKeyerIsIdle(const KeyCaptureKeyer *keyer)
+{
+    if (keyer->state == KEY_CAPTURE_STATE_IDLE && tails[keyer->channel] == heads[keyer->channel] &&
+            !(lastStates & (1 << keyer->channel))) {
+        return TRUE;
+    }
+    return FALSE;
+}
+
+uint32_t KeyCaptureGetOverflows(void)
+{
+    return overflows;
+}
+
+void KeyCapturePutEdge(uint32_t time, int pressed)
+{
+    KeyCapturePut(KEY_CAPTURE_CHANNEL_TONE, time, pressed);
+}
+
+void __ISR(_CHANGE_NOTICE_VECTOR, IPL5AUTO) KeyCaptureInterrupt(void)
+{
+    uint32_t now = ReadCoreTimer();
+    uint8_t states;
+    uint8_t changed;
+    int channel;
+
+    // Reading the port clears the mismatch that raised the interrupt.
+    (void) PORTD;
+    INTClearFlag(INT_CN);
+    states = BUTTON_STATES();
+    changed = states ^ lastStates;
+
+    for (channel = KEY_CAPTURE_FIRST_CHANNEL; channel < MORSE_NUM_CHANNELS; ++channel) {
+        uint8_t mask = 1 << channel;
+        if ((changed & mask) && now - lastTimes[channel] >= holdoffCounts) {
+            KeyCapturePut(channel, now, states & mask);
+        }
+    }
+}
+
+/**
+ * Queues an edge and makes it the last accepted one for its channel. Must only be called with the
+ * change-notice interrupt unable to run, which is always true from within it or from another
+ * interrupt at the same priority.
+ */
+static void KeyCapturePut(MorseChannel channel, uint32_t time, uint8_t pressed)
+{
+    uint8_t mask = 1 << channel;
+    KeyCaptureEdge *edge;
+    lastTimes[channel] = time;
+    lastStates = pressed ? (lastStates | mask) : (lastStates & ~mask);
+    if (heads[channel] - tails[channel] == KEY_CAPTURE_EDGE_QUEUE_SIZE) {
+        overflows++;
+        return;
+    }
+    edge = &edges[channel][heads[channel] & (KEY_CAPTURE_EDGE_QUEUE_SIZE - 1)];
+    edge->time = time;
+    edge->pressed = pressed ? TRUE : FALSE;
+    heads[channel]++;
+    TRACE(pressed ? TRACE_ID_EDGE_DOWN : TRACE_ID_EDGE_UP, channel);
+    if (edgeRecorder != NULL) {
+        EventLogRecordEdge(edgeRecorder, channel, time, edge->pressed);
+    }
+    if (edgeCallback != NULL) {
+        edgeCallback();
+    }
+}
+
+/**
+ * Catches a button that bounced into a different state during its hold-off, which the interrupt
+ * ignored. The edge is stamped with the current time since the real time is unknown. Every
+ * interrupt is held off, since any at the change-notice priority may put an edge.
+ */
+static void KeyCaptureResync(MorseChannel channel)
+{
+    uint8_t mask = 1 << channel;
+    unsigned int status;
+    uint32_t now;
+    if (channel == KEY_CAPTURE_CHANNEL_TONE) {
+        return;
+    }
+    status = INTDisableInterrupts();
+    now = ReadCoreTimer();
+    if (now - lastTimes[channel] >= holdoffCounts && ((BUTTON_STATES() ^ lastStates) & mask)) {
+        KeyCapturePut(channel, now, BUTTON_STATES() & mask);
+    }
+    INTRestoreInterrupts(status);
+}
+
+/**
+ * Traces an event a keyer is about to return, and returns it.
+ */
+static MorseEvent KeyCaptureTraceEvent(MorseChannel channel, MorseEvent event)
+{
+    TRACE(TRACE_ID_EVENT, (channel << 8) | event);
+    return event;
+}
+
+/**
+ * Converts the core timer counts between two times into microseconds. Unsigned subtraction keeps
+ * this correct when the timer wraps in between.
+ */
+static uint32_t KeyCaptureElapsed(uint32_t from, uint32_t to)
+{
+    return (to - from) / countsPerUs;
+}
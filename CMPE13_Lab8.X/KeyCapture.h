@@ -0,0 +1,150 @@
+#ifndef KEY_CAPTURE_H
+#define KEY_CAPTURE_H
+
+/**
+ * @file
+ *
+ * This library times Morse keying from button edges instead of by counting 100Hz polls. Every
+ * change of a button's pin raises a change-notice interrupt, which timestamps the edge with the
+ * free-running core timer and queues it for that button. Key-down and key-up times are then known
+ * to within a microsecond, instead of to within a 10ms tick plus the 40ms of debouncing done by
+ * Buttons.h.
+ *
+ * Contacts bounce, so once an edge has been accepted any further changes on that button are
+ * ignored for KEY_CAPTURE_HOLDOFF_US. The first edge of a bounce is the real one, so this doesn't
+ * delay or skew the timestamp. If the button settled in a different state than the last accepted
+ * edge, that is caught by KeyCaptureCheckEvents() once the hold-off has passed.
+ *
+ * Only BTN2-BTN4 can be captured: they are on RD5-RD7, which are change-notice pins CN14-CN16,
+ * while BTN1 is on RF1, which has no change-notice input on this part. Edges that are detected in
+ * software instead, such as by ToneDetect.h, are queued on KEY_CAPTURE_CHANNEL_TONE with
+ * KeyCapturePutEdge() and from then on are handled exactly like those of a button.
+ *
+ * Edges are turned into the usual MorseEvents by KeyCaptureCheckEvents(), which only has to be
+ * called often enough to notice the letter and word gaps on time; the 100Hz timer is plenty for
+ * that. Once a keyer is idle that timer can even be stopped or slowed, and sped up again from the
+ * callback given to KeyCaptureInit() on the next edge. All durations are in microseconds, so a
+ * MorseTiming used with a KeyCaptureKeyer must be initialized with KEY_CAPTURE_TICKS_PER_SECOND.
+ *
+ * Example usage for keying from BTN4:
+ * static KeyCaptureKeyer key;
+ * static MorseTiming timing;
+ *
+ * KeyCaptureInit(NULL);
+ * KeyCaptureKeyerInit(&key, MORSE_CHANNEL_BTN4);
+ * MorseTimingInit(&timing, 250000, KEY_CAPTURE_TICKS_PER_SECOND);
+ * KeyCaptureKeyerSetTiming(&key, &timing);
+ *
+ * // In the 100Hz ISR:
+ * MorseEvent event = KeyCaptureCheckEvents(&key);
+ */
+
+#include <stdint.h>
+#include "EventLog.h"
+#include "Morse.h"
+#include "MorseTiming.h"
+
+// All durations measured by this library are in microseconds.
+#define KEY_CAPTURE_TICKS_PER_SECOND 1000000
+
+// How long further changes on a button are ignored after one of its edges was accepted.
+#define KEY_CAPTURE_HOLDOFF_US 5000
+
+// The channel past the buttons whose edges are put by software with KeyCapturePutEdge().
+#define KEY_CAPTURE_CHANNEL_TONE ((MorseChannel) MORSE_NUM_CHANNELS)
+#define KEY_CAPTURE_NUM_CHANNELS (MORSE_NUM_CHANNELS + 1)
+
+// How many edges can be queued for each channel before new ones are dropped. Must be a power of
+// two.
+#define KEY_CAPTURE_EDGE_QUEUE_SIZE 16
+
+/**
+ * This enum lists the states of the timing state machine run by KeyCaptureCheckEvents().
+ */
+typedef enum {
+    KEY_CAPTURE_STATE_IDLE,         /// No letter in progress, so gaps aren't timed.
+    KEY_CAPTURE_STATE_DOWN,         /// The key is down.
+    KEY_CAPTURE_STATE_ELEMENT_GAP,  /// The key is up after an element, before an INTER_LETTER.
+    KEY_CAPTURE_STATE_LETTER_GAP    /// The key is up after an INTER_LETTER, before an INTER_WORD.
+} KeyCaptureState;
+
+/**
+ * A function called from the change-notice interrupt right after each edge has been queued.
+ */
+typedef void (*KeyCaptureCallback)(void);
+
+/**
+ * A KeyCaptureKeyer holds the state for turning one button's edges into MorseEvents. Its members
+ * should be treated as private and only be changed through the functions below.
+ */
+typedef struct {
+    MorseChannel channel;
+    KeyCaptureState state;
+    uint32_t edgeTime;
+    MorseTiming *timing;
+} KeyCaptureKeyer;
+
+/**
+ * Enables change-notice interrupts on BTN2-BTN4 and starts capturing edges on all of them. The
+ * buttons must already be configured as inputs, such as by ButtonsInit().
+ * @param callback Called after every queued edge, or NULL. It runs within the change-notice
+ *                 interrupt, so it should be short.
+ */
+void KeyCaptureInit(KeyCaptureCallback callback);
+
+/**
+ * Starts or stops recording every queued edge of every channel to an EventLog, as it is queued.
+ * Edges are recorded from within the interrupt that queued them, so the recorder's sink must be
+ * safe to call from the change-notice priority, as UartWrite() is.
+ * @param recorder A recorder set up with EventLogRecorderInit(), or NULL to stop recording.
+ */
+void KeyCaptureSetRecorder(EventLogRecorder *recorder);
+
+/**
+ * Initializes a keyer for the given button and drops any edges already queued for it.
+ * @param keyer The keyer to initialize.
+ * @param channel Which button the keyer reads, or KEY_CAPTURE_CHANNEL_TONE. Must not be
+ *                MORSE_CHANNEL_BTN1.
+ * @return SUCCESS or STANDARD_ERROR if the channel can't be captured.
+ */
+int KeyCaptureKeyerInit(KeyCaptureKeyer *keyer, MorseChannel channel);
+
+/**
+ * Uses the thresholds from `timing` to classify presses and gaps, and adds the length of every
+ * press to it. Without a timing, which is the default, the fixed MorseEventLengths are used.
+ * @param keyer The keyer to change.
+ * @param timing The timing to use, initialized with KEY_CAPTURE_TICKS_PER_SECOND, or NULL.
+ */
+void KeyCaptureKeyerSetTiming(KeyCaptureKeyer *keyer, MorseTiming *timing);
+
+/**
+ * Turns the edges queued for the keyer's button into MorseEvents. A DOT or DASH is returned as
+ * soon as the key is released, and INTER_LETTER and INTER_WORD once the key has stayed up long
+ * enough. At most one event is returned per call, and any remaining edges are left for the next.
+ * @param keyer The keyer to check.
+ * @return The MorseEvent that occurred, or MORSE_EVENT_NONE.
+ */
+MorseEvent KeyCaptureCheckEvents(KeyCaptureKeyer *keyer);
+
+/**
+ * Returns whether the keyer is waiting for a new word with the key up and no edges queued, so
+ * KeyCaptureCheckEvents() can't return anything until the next edge.
+ * @return TRUE if idle, FALSE otherwise.
+ */
+int KeyCaptureKeyerIsIdle(const KeyCaptureKeyer *keyer);
+
+/**
+ * Queues an edge on KEY_CAPTURE_CHANNEL_TONE, which is then timed like a button's. The callback
+ * given to KeyCaptureInit() is called just as for a button. Must be called from an interrupt at
+ * the change-notice priority, level 5, which keeps it from racing with the capture of buttons.
+ * @param time When the edge happened, read with ReadCoreTimer().
+ * @param pressed TRUE if the key went down, FALSE if it went up.
+ */
+void KeyCapturePutEdge(uint32_t time, int pressed);
+
+/**
+ * Returns how many edges have been dropped across all channels because their queue was full.
+ */
+uint32_t KeyCaptureGetOverflows(void);
+
+#endif // KEY_CAPTURE_H
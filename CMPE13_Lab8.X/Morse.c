@@ -1,50 +1,164 @@
 /**
- * This library implements functions for decoding Morse code. It builds upon the Tree library to use
- * a binary tree data structure for storing the codepoints for all characters. Decoding is then done
- * through simple tree traversal. Additional functionality relies on a 100Hz clock to check the
- * button states for decoding the input of Morse characters through a physical button (BTN4).
+ * This library implements functions for decoding Morse code. It uses the flat layout from the Tree
+ * library to store a binary tree of the codepoints for all characters as a `const` table generated
+ * from MorseTable.h. Decoding is then done through simple tree traversal. Additional functionality
+ * relies on a 100Hz clock to check the button states for decoding the input of Morse characters
+ * through a physical button (BTN4).
  */
 
 #include <stdint.h>
 #include "Morse.h"
+#include "MorseTable.h"
 #include "Tree.h"
 #include "Buttons.h"
 #include "BOARD.h"
 
 
-Node *chartree;
-Node *temp;
+// The number of vertical levels in the Morse tree, one more than the longest code it holds.
+#define MORSE_TREE_LEVELS (MORSE_SYMBOL_MAX_LENGTH + 1)
 
-enum {
-    WAITING,
-    DOT,
-    DASH,
-    INTER_LETTER
-} Mstate = WAITING;
+// The flat Morse tree, generated from MorseTable.h at compile time and stored in flash. With codes
+// of up to 7 elements this is 256 chars, one per packed code, so a decoding position always fits
+// in a uint8_t and every step only needs the bounds check against the tree size.
+#define MORSE_TREE_ENTRY(c, length, elements) [MORSE_CODE(length, elements)] = c,
+static const char chartree[TREE_ARRAY_SIZE(MORSE_TREE_LEVELS)] = {
+    MORSE_CODE_TABLE(MORSE_TREE_ENTRY)
+};
+
+// Every code must fit within the tree and only use as many element bits as it is long.
+#define MORSE_TREE_CODE_INVALID(c, length, elements) \
+    || (length) < 1 || (length) >= MORSE_TREE_LEVELS || (elements) >= (1 << (length))
+typedef char MorseTreeCheckCodes[(0 MORSE_CODE_TABLE(MORSE_TREE_CODE_INVALID)) ? -1 : 1];
+
+/**
+ * Never called; this only exists so that the compiler rejects MorseTable.h if two characters share
+ * a code or one character is given two codes, as either shows up as a duplicate case label. This
+ * guarantees that decoding through chartree and encoding from MorseTable.h are exact inverses.
+ */
+#define MORSE_TREE_CASE_CODE(c, length, elements) case MORSE_CODE(length, elements): break;
+#define MORSE_TREE_CASE_CHAR(c, length, elements) case c: break;
+static inline void MorseTreeCheckUnique(int code, char c)
+{
+    switch (code) {
+        MORSE_CODE_TABLE(MORSE_TREE_CASE_CODE)
+    }
+    switch (c) {
+        MORSE_CODE_TABLE(MORSE_TREE_CASE_CHAR)
+    }
+}
+
+// The nearest character and percent confidence for every position in chartree, for error-tolerant
+// decoding. Only filled in once a decoder first needs it, since it costs 512 bytes of RAM instead
+// of flash.
+#define MORSE_CONFIDENCE_EXACT 100
+static char nearestChars[TREE_ARRAY_SIZE(MORSE_TREE_LEVELS)];
+static uint8_t nearestConfidences[TREE_ARRAY_SIZE(MORSE_TREE_LEVELS)];
+static uint8_t nearestReady;
+
+static void MorseNearestInit(void);
+static int MorseCodeDistance(int a, int b);
+
+// The edges of a button in one tick, as its pair of UP/DOWN flags shifted down to the bits of BTN1
+// within the ButtonsCheckEvents() bitmask so that they can index the transition table directly.
+#define MORSE_EDGE_NONE 0
+#define MORSE_EDGE_UP BUTTON_EVENT_1UP
+#define MORSE_EDGE_DOWN BUTTON_EVENT_1DOWN
+#define MORSE_EDGE_BOTH (BUTTON_EVENT_1UP | BUTTON_EVENT_1DOWN)
+#define MORSE_NUM_EDGES (MORSE_EDGE_BOTH + 1)
+#define MORSE_CHANNEL_EDGES(buttonEvents, channel) \
+    (((buttonEvents) >> (2 * (channel))) & MORSE_EDGE_BOTH)
+
+#define MORSE_NUM_STATES (MORSE_STATE_INTER_WORD + 1)
+
+// What a transition does besides changing state and returning its event. KEY_UP adds the press
+// to an adaptive timing, and RESTART then starts counting ticks from 0 again.
+#define MORSE_ACTION_RESTART 0x1
+#define MORSE_ACTION_KEY_UP  0x2
+
+typedef struct {
+    uint8_t next;
+    uint8_t event;
+    uint8_t actions;
+} MorseTransition;
+
+/**
+ * The timing state machine of MorseDecoderCheckEvents(), indexed by the current state, the edges of
+ * the decoder's button this tick and whether the ticks spent in the state have reached its
+ * threshold. Each state that times something has one threshold: DOT the DOT vs. DASH length,
+ * INTER_LETTER the end of a letter and INTER_WORD the end of a word, the last two both measured
+ * from the release. WAITING and DASH have none, so both halves of their rows are the same.
+ *
+ * A press and release in the same tick is taken as whichever edge the state is waiting for, and
+ * an edge the state isn't waiting for is ignored.
+ */
+#define MORSE_TO(state, event, actions) {MORSE_STATE_##state, MORSE_EVENT_##event, (actions)}
+#define MORSE_STAY(state) MORSE_TO(state, NONE, 0)
+#define MORSE_PRESS(event) MORSE_TO(DOT, event, MORSE_ACTION_RESTART)
+#define MORSE_RELEASE(event) \
+    MORSE_TO(INTER_LETTER, event, MORSE_ACTION_RESTART | MORSE_ACTION_KEY_UP)
+static const MorseTransition transitions[MORSE_NUM_STATES][MORSE_NUM_EDGES][2] = {
+    [MORSE_STATE_WAITING] = {
+        [MORSE_EDGE_NONE] = {MORSE_TO(WAITING, NONE, MORSE_ACTION_RESTART),
+                             MORSE_TO(WAITING, NONE, MORSE_ACTION_RESTART)},
+        [MORSE_EDGE_UP] = {MORSE_TO(WAITING, NONE, MORSE_ACTION_RESTART),
+                           MORSE_TO(WAITING, NONE, MORSE_ACTION_RESTART)},
+        [MORSE_EDGE_DOWN] = {MORSE_PRESS(NONE), MORSE_PRESS(NONE)},
+        [MORSE_EDGE_BOTH] = {MORSE_PRESS(NONE), MORSE_PRESS(NONE)}
+    },
+    [MORSE_STATE_DOT] = {
+        [MORSE_EDGE_NONE] = {MORSE_STAY(DOT), MORSE_STAY(DASH)},
+        [MORSE_EDGE_UP] = {MORSE_RELEASE(DOT), MORSE_RELEASE(DASH)},
+        [MORSE_EDGE_DOWN] = {MORSE_STAY(DOT), MORSE_STAY(DASH)},
+        [MORSE_EDGE_BOTH] = {MORSE_RELEASE(DOT), MORSE_RELEASE(DASH)}
+    },
+    [MORSE_STATE_DASH] = {
+        [MORSE_EDGE_NONE] = {MORSE_STAY(DASH), MORSE_STAY(DASH)},
+        [MORSE_EDGE_UP] = {MORSE_RELEASE(DASH), MORSE_RELEASE(DASH)},
+        [MORSE_EDGE_DOWN] = {MORSE_STAY(DASH), MORSE_STAY(DASH)},
+        [MORSE_EDGE_BOTH] = {MORSE_RELEASE(DASH), MORSE_RELEASE(DASH)}
+    },
+    [MORSE_STATE_INTER_LETTER] = {
+        [MORSE_EDGE_NONE] = {MORSE_STAY(INTER_LETTER), MORSE_TO(INTER_WORD, INTER_LETTER, 0)},
+        [MORSE_EDGE_UP] = {MORSE_STAY(INTER_LETTER), MORSE_TO(INTER_WORD, INTER_LETTER, 0)},
+        [MORSE_EDGE_DOWN] = {MORSE_PRESS(NONE), MORSE_PRESS(INTER_LETTER)},
+        [MORSE_EDGE_BOTH] = {MORSE_PRESS(NONE), MORSE_PRESS(INTER_LETTER)}
+    },
+    [MORSE_STATE_INTER_WORD] = {
+        [MORSE_EDGE_NONE] = {MORSE_STAY(INTER_WORD),
+                             MORSE_TO(WAITING, INTER_WORD, MORSE_ACTION_RESTART)},
+        [MORSE_EDGE_UP] = {MORSE_STAY(INTER_WORD),
+                           MORSE_TO(WAITING, INTER_WORD, MORSE_ACTION_RESTART)},
+        [MORSE_EDGE_DOWN] = {MORSE_PRESS(NONE), MORSE_PRESS(INTER_WORD)},
+        [MORSE_EDGE_BOTH] = {MORSE_PRESS(NONE), MORSE_PRESS(INTER_WORD)}
+    }
+};
+
+// The thresholds of a decoder without a MorseTiming: the fixed lengths in MorseEventLength.
+static const MorseTiming fixedTiming = {
+    .ticksPerSecond = MORSE_TICKS_PER_SECOND,
+    .unit = MORSE_EVENT_LENGTH_DOWN_DOT,
+    .dashThreshold = MORSE_EVENT_LENGTH_DOWN_DASH,
+    .letterThreshold = MORSE_EVENT_LENGTH_UP_INTER_LETTER,
+    .wordThreshold = MORSE_EVENT_LENGTH_UP_INTER_WORD
+};
+
+// The decoder used by the functions that don't take one. Its node is 0 until MorseInit() runs,
+// which is never a valid position in chartree.
+static MorseDecoder defaultDecoder;
 
 /**
- * This function initializes the Morse code decoder. This is primarily the generation of the
- * Morse tree: a binary tree consisting of all of the ASCII alphanumeric characters arranged
- * according to the DOTs and DASHes that represent each character. Traversal of the tree is done by
- * taking the left-child if it is a dot and the right-child if it is a dash. If the morse tree is
- * successfully generated, SUCCESS is returned, otherwise STANDARD_ERROR is returned. This function
- * also initializes the Buttons library so that MorseCheckEvents() can work properly.
- * @return Either SUCCESS if the decoding tree was successfully created or STANDARD_ERROR if not.
+ * This function initializes the Morse code decoder. The Morse tree, a binary tree consisting of all
+ * of the characters in MorseTable.h arranged according to the DOTs and DASHes that represent
+ * each character, is generated at compile time from MorseTable.h, so this only resets the decoding
+ * position to its root. Traversal of the tree is done by taking the left-child if it is a dot and
+ * the right-child if it is a dash. This function also initializes the Buttons library so that
+ * MorseCheckEvents() can work properly.
+ * @return SUCCESS, as the decoding tree no longer has to be created at runtime.
  */
 int MorseInit(void)
 {
     ButtonsInit();
-    char tree[63] = {'\0', 'E', 'I', 'S', 'H', '5', '4', 'V', '\0', '3', 'U', 'F', '\0', '\0', '\0', '\0', '2',
-        'A', 'R', 'L', '\0', '\0', '\0', '\0', '\0', 'W', 'P', '\0', '\0', 'J', '\0', '1',
-        'T', 'N', 'D', 'B', '6', '\0', 'X', '\0', '\0', 'K', 'C', '\0', '\0', 'Y', '\0', '\0',
-        'M', 'G', 'Z', '7', '\0', 'Q', '\0', '\0', 'O', '\0', '8', '\0', '\0', '9', '0'};
-    chartree = TreeCreate(6, tree);
-    if (chartree == NULL) {
-        return STANDARD_ERROR;
-    } else {
-        temp = chartree;
-        return SUCCESS;
-    }
+    return MorseDecoderInit(&defaultDecoder, MORSE_CHANNEL_BTN4);
 }
 
 /**
@@ -65,104 +179,284 @@ int MorseInit(void)
  *         or `in` isn't a valid member of the MorseChar enum.
  */
 char MorseDecode(MorseChar in)
+{
+    return MorseDecoderDecode(&defaultDecoder, in);
+}
+
+char MorseDecodeSymbol(uint8_t length, uint8_t elements)
+{
+    if (length > MORSE_SYMBOL_MAX_LENGTH || (elements >> length) != 0) {
+        return STANDARD_ERROR;
+    }
+    return chartree[MORSE_CODE(length, elements)];
+}
+
+int MorseDecodeString(const char *in, char *out, int outLen, int *errorPos)
+{
+    const char *start = in;
+    const char *letterStart = in;
+    uint32_t code = TREE_ARRAY_ROOT;
+    int length = 0;
+    int result = (outLen < 1) ? SIZE_ERROR : SUCCESS;
+
+    for (; result == SUCCESS; ++in) {
+        char c = *in;
+        if (c == MORSE_CHAR_DOT || c == MORSE_CHAR_DASH) {
+            if (code == TREE_ARRAY_ROOT) {
+                letterStart = in;
+            }
+            code = (code << 1) | (c == MORSE_CHAR_DASH);
+            if (code >= TREE_ARRAY_SIZE(MORSE_TREE_LEVELS)) {
+                result = STANDARD_ERROR;
+            }
+        } else if (c == ' ' || c == MORSE_CHAR_END_OF_CHAR || c == '\0') {
+            if (code != TREE_ARRAY_ROOT) {
+                if (chartree[code] == '\0') {
+                    result = STANDARD_ERROR;
+                } else if (length + 1 >= outLen) {
+                    result = SIZE_ERROR;
+                } else {
+                    out[length++] = chartree[code];
+                    code = TREE_ARRAY_ROOT;
+                }
+            } else if (c == ' ') {
+                letterStart = in;
+                if (length + 1 >= outLen) {
+                    result = SIZE_ERROR;
+                } else {
+                    out[length++] = ' ';
+                }
+            }
+            if (c == '\0') {
+                break;
+            }
+        } else {
+            letterStart = in;
+            result = STANDARD_ERROR;
+        }
+    }
+
+    if (outLen > 0) {
+        out[length] = '\0';
+    }
+    if (result != SUCCESS && errorPos != NULL) {
+        *errorPos = letterStart - start;
+    }
+    return result;
+}
+
+/**
+ * This function calls ButtonsCheckEvents() once per call and returns which, if any,
+ * of the Morse code events listed in the enum above have been encountered. It checks for BTN4
+ * events in its input and should be called at 100Hz so that the timing works. A press shorter
+ * than MORSE_EVENT_LENGTH_DOWN_DASH (0.5s) is a DOT and any longer one a DASH, each reported as
+ * soon as the button is released. The button then has to stay up for
+ * MORSE_EVENT_LENGTH_UP_INTER_LETTER (1s) to end the letter and MORSE_EVENT_LENGTH_UP_INTER_WORD
+ * (2s) to end the word, both counted from the release.
+ *
+ * @note This function assumes that the buttons are all unpressed at startup, so that the first
+ *       event it will see is a BUTTON_EVENT_*DOWN.
+ *
+ * So pressing the button for 0.3s, releasing it for 0.2s, pressing it for 0.6s, and then waiting
+ * will decode the string '.-' (A). Counting from the first press, it will trigger a
+ * MORSE_EVENT_DOT at 0.3s, a MORSE_EVENT_DASH at 1.1s, a MORSE_EVENT_INTER_LETTER at 2.1s and a
+ * MORSE_EVENT_INTER_WORD at 3.1s, with a MORSE_EVENT_NONE on every other tick.
+ * 
+ * @return The MorseEvent that occurred.
+ */
+
+MorseEvent MorseCheckEvents(void)
+{
+    return MorseDecoderCheckEvents(&defaultDecoder, ButtonsCheckEvents());
+}
+
+int MorseDecoderInit(MorseDecoder *decoder, MorseChannel channel)
+{
+    if (decoder == NULL || channel > MORSE_CHANNEL_BTN4) {
+        return STANDARD_ERROR;
+    }
+    decoder->channel = channel;
+    decoder->state = MORSE_STATE_WAITING;
+    decoder->ticks = 0;
+    decoder->node = TREE_ARRAY_ROOT;
+    decoder->tolerant = FALSE;
+    decoder->confidence = 0;
+    decoder->timing = NULL;
+    return SUCCESS;
+}
+
+void MorseDecoderSetTiming(MorseDecoder *decoder, MorseTiming *timing)
+{
+    decoder->timing = timing;
+}
+
+char MorseDecoderDecode(MorseDecoder *decoder, MorseChar in)
 {
     char tempchar;
+    if (decoder->node == 0) {
+        return STANDARD_ERROR;
+    }
     if (in == MORSE_CHAR_DOT) {
-        if (temp->leftChild == NULL) {
+        if (TREE_ARRAY_LEFT(decoder->node) >= TREE_ARRAY_SIZE(MORSE_TREE_LEVELS)) {
             return STANDARD_ERROR;
         }
-        temp = temp->leftChild;
+        decoder->node = TREE_ARRAY_LEFT(decoder->node);
         return SUCCESS;
     } else if (in == MORSE_CHAR_DASH) {
-        if (temp->rightChild == NULL) {
+        if (TREE_ARRAY_RIGHT(decoder->node) >= TREE_ARRAY_SIZE(MORSE_TREE_LEVELS)) {
             return STANDARD_ERROR;
         }
-        temp = temp->rightChild;
+        decoder->node = TREE_ARRAY_RIGHT(decoder->node);
         return SUCCESS;
     } else if (in == MORSE_CHAR_END_OF_CHAR) {
-        tempchar = temp->data;
-        temp = chartree;
+        if (decoder->tolerant) {
+            tempchar = nearestChars[decoder->node];
+            decoder->confidence = nearestConfidences[decoder->node];
+        } else {
+            tempchar = chartree[decoder->node];
+            decoder->confidence = tempchar ? MORSE_CONFIDENCE_EXACT : 0;
+        }
+        decoder->node = TREE_ARRAY_ROOT;
         return tempchar;
     } else if (in == MORSE_CHAR_DECODE_RESET) {
-        temp = chartree;
+        decoder->node = TREE_ARRAY_ROOT;
         return SUCCESS;
     } else {
         return STANDARD_ERROR;
     }
-    return SUCCESS;
+}
+
+void MorseDecoderSetTolerant(MorseDecoder *decoder, int tolerant)
+{
+    if (tolerant && !nearestReady) {
+        MorseNearestInit();
+    }
+    decoder->tolerant = tolerant ? TRUE : FALSE;
+}
+
+uint8_t MorseDecoderGetConfidence(const MorseDecoder *decoder)
+{
+    return decoder->confidence;
+}
+
+MorseEvent MorseDecoderCheckEvents(MorseDecoder *decoder, uint8_t buttonEvents)
+{
+    const MorseTiming *timing = decoder->timing != NULL ? decoder->timing : &fixedTiming;
+    uint32_t thresholds[MORSE_NUM_STATES] = {
+        [MORSE_STATE_DOT] = timing->dashThreshold,
+        [MORSE_STATE_INTER_LETTER] = timing->letterThreshold,
+        [MORSE_STATE_INTER_WORD] = timing->wordThreshold
+    };
+    const MorseTransition *transition;
+
+    decoder->ticks++;
+    transition = &transitions[decoder->state][MORSE_CHANNEL_EDGES(buttonEvents, decoder->channel)]
+            [decoder->ticks >= thresholds[decoder->state]];
+    if ((transition->actions & MORSE_ACTION_KEY_UP) && decoder->timing != NULL) {
+        MorseTimingAddPress(decoder->timing, decoder->ticks);
+    }
+    if (transition->actions & MORSE_ACTION_RESTART) {
+        decoder->ticks = 0;
+    }
+    decoder->state = transition->next;
+    return transition->event;
+}
+
+uint16_t MorseCheckChannelEvents(MorseDecoder *decoders, int count)
+{
+    uint8_t buttonEvents = ButtonsCheckEvents();
+    uint16_t events = 0;
+    int i;
+
+    for (i = 0; i < count && i < MORSE_NUM_CHANNELS; ++i) {
+        MorseEvent event = MorseDecoderCheckEvents(&decoders[i], buttonEvents);
+        events |= (uint16_t) event << (4 * decoders[i].channel);
+    }
+    return events;
 }
 
 /**
- * This function calls ButtonsCheckEvents() once per call and returns which, if any,
- * of the Morse code events listed in the enum above have been encountered. It checks for BTN4
- * events in its input and should be called at 100Hz so that the timing works. The
- * length that BTN4 needs to be held down for a dot is >= 0.25s and < 0.50s with a dash being a button
- * down event for >= 0.5s. The button uptime various between dots/dashes (>= .5s), letters
- * (>= 1s), and words (>= 2s) Letters > 1s; words greater than 2s.
- *
- * @note This function assumes that the buttons are all unpressed at startup, so that the first
- *       event it will see is a BUTTON_EVENT_*DOWN.
- *
- * So pressing the button for 0.1s, releasing it for 0.1s, pressing it for 0.3s, and then waiting
- * will decode the string '.-' (A). It will trigger the following order of events:
- * 9 MORSE_EVENT_NONEs, 1 MORSE_EVENT_DOT, 39 MORSE_EVENT_NONEs, a MORSE_EVENT_DASH, 69
- * MORSE_EVENT_NONEs, a MORSE_EVENT_END_CHAR, and then MORSE_EVENT_INTER_WORDs.
- * 
- * @return The MorseEvent that occurred.
+ * Fills in the nearest character for every position in chartree. Ties go to the character with
+ * the lowest position, which is the shortest code and so usually the most common character.
  */
+static void MorseNearestInit(void)
+{
+    int code;
+    int other;
 
-uint8_t first = 0;
-int increment = 0;
+    for (code = TREE_ARRAY_ROOT; code < TREE_ARRAY_SIZE(MORSE_TREE_LEVELS); ++code) {
+        int best = MORSE_SYMBOL_MAX_LENGTH + 1;
+        int ties = 0;
 
-MorseEvent MorseCheckEvents(void)
-{
-    increment++;
-    first = ButtonsCheckEvents();
-    switch (Mstate) {
-    case WAITING:
-        increment = 0;
-        if (first == BUTTON_EVENT_4DOWN) {
-            printf("Button 4 Pressed");
-            Mstate = DOT;
-        } else {
-            Mstate = WAITING;
-        }
-        break;
-    case DOT:
-        if (first == BUTTON_EVENT_4UP) {
-            printf("Button 4 Up");
-            increment = 0;
-            Mstate = INTER_LETTER;
-            return MORSE_EVENT_DOT;
+        if (chartree[code] != '\0') {
+            nearestChars[code] = chartree[code];
+            nearestConfidences[code] = MORSE_CONFIDENCE_EXACT;
+            continue;
         }
-        if (increment > MORSE_EVENT_LENGTH_DOWN_DASH) {
-            Mstate = DASH;
-        }
-        break;
-    case DASH:
-        if (first == BUTTON_EVENT_4UP) {
-            printf("Button 4 Up");
-            increment = 0;
-            Mstate = INTER_LETTER;
-            return MORSE_EVENT_DASH;
-        }
-        break;
-    case INTER_LETTER:
-        if (increment >= MORSE_EVENT_LENGTH_UP_INTER_LETTER) {
-            Mstate = WAITING;
-            return MORSE_EVENT_INTER_WORD;
-        }
-        if (first == BUTTON_EVENT_4DOWN) {
-            if (increment >= MORSE_EVENT_LENGTH_UP_INTER_LETTER) {
-                increment = 0;
-                Mstate = DOT;
-                return MORSE_EVENT_INTER_LETTER;
+        nearestChars[code] = STANDARD_ERROR;
+        for (other = TREE_ARRAY_ROOT; other < TREE_ARRAY_SIZE(MORSE_TREE_LEVELS); ++other) {
+            int distance;
+            if (chartree[other] == '\0') {
+                continue;
+            }
+            distance = MorseCodeDistance(code, other);
+            if (distance < best) {
+                best = distance;
+                ties = 1;
+                nearestChars[code] = chartree[other];
+            } else if (distance == best) {
+                ties++;
             }
-            increment = 0;
-            Mstate = DOT;
         }
-        break;
+        nearestConfidences[code] = ties ? MORSE_CONFIDENCE_EXACT / (best + 1) / ties : 0;
     }
-    return MORSE_EVENT_NONE;
 
-}
\ No newline at end of file
+    // An empty symbol isn't a mistyped character, so it never decodes.
+    nearestChars[TREE_ARRAY_ROOT] = STANDARD_ERROR;
+    nearestConfidences[TREE_ARRAY_ROOT] = 0;
+    nearestReady = TRUE;
+}
+
+/**
+ * Returns the edit distance between two packed codes: the fewest DOTs or DASHes that have to be
+ * inserted, deleted or swapped to turn one into the other.
+ */
+static int MorseCodeDistance(int a, int b)
+{
+    int row[MORSE_SYMBOL_MAX_LENGTH + 1];
+    int aLength = 0;
+    int bLength = 0;
+    int i;
+    int j;
+
+    while ((a >> (aLength + 1)) != 0) {
+        aLength++;
+    }
+    while ((b >> (bLength + 1)) != 0) {
+        bLength++;
+    }
+
+    // The classic dynamic program, keeping only one row. Element i of a code, counting from the
+    // first, is bit (length - 1 - i).
+    for (j = 0; j <= bLength; ++j) {
+        row[j] = j;
+    }
+    for (i = 1; i <= aLength; ++i) {
+        int diagonal = row[0];
+        int aElement = (a >> (aLength - i)) & 1;
+        row[0] = i;
+        for (j = 1; j <= bLength; ++j) {
+            int bElement = (b >> (bLength - j)) & 1;
+            int cost = diagonal + (aElement != bElement);
+            diagonal = row[j];
+            if (row[j] + 1 < cost) {
+                cost = row[j] + 1;
+            }
+            if (row[j - 1] + 1 < cost) {
+                cost = row[j - 1] + 1;
+            }
+            row[j] = cost;
+        }
+    }
+    return row[bLength];
+}
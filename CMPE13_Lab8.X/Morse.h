@@ -2,13 +2,15 @@
 #define MORSE_H
 
 /**
- * This library implements functions for decoding Morse code. It builds upon the Tree library to use
- * a binary tree data structure for storing the codepoints for all characters. Decoding is then done
- * through simple tree traversal. Additional functionality relies on a 100Hz clock to check the
- * button states for decoding the input of Morse characters through a physical button (BTN4).
+ * This library implements functions for decoding Morse code. It uses the flat layout from the Tree
+ * library to store a binary tree of the codepoints for all characters as a `const` table generated
+ * from MorseTable.h. Decoding is then done through simple tree traversal. Additional functionality
+ * relies on a 100Hz clock to check the button states for decoding the input of Morse characters
+ * through a physical button (BTN4).
  */
 
 #include <stdint.h>
+#include "MorseTiming.h"
 
 /**
  * This enum specifies the different possible inputs to MorseDecode().
@@ -37,6 +39,9 @@ typedef enum {
 	MORSE_EVENT_INTER_WORD
 } MorseEvent;
 
+// The rate at which MorseCheckEvents() and MorseDecoderCheckEvents() must be called.
+#define MORSE_TICKS_PER_SECOND 100
+
 /**
  * Define the length of time, in units of .01s, that either button-presses or time between button
  * presses should be.
@@ -52,13 +57,52 @@ typedef enum {
 } MorseEventLength;
 
 /**
- * This function initializes the Morse code decoder. This is primarily the generation of the
- * Morse tree: a binary tree consisting of all of the ASCII alphanumeric characters arranged
- * according to the DOTs and DASHes that represent each character. Traversal of the tree is done by
- * taking the left-child if it is a dot and the right-child if it is a dash. If the morse tree is
- * successfully generated, SUCCESS is returned, otherwise STANDARD_ERROR is returned. This function
- * also initializes the Buttons library so that MorseCheckEvents() can work properly.
- * @return Either SUCCESS if the decoding tree was successfully created or STANDARD_ERROR if not.
+ * This enum lists the buttons that a MorseDecoder can be keyed from. Each value is also the index
+ * of that button's pair of UP/DOWN flags within the ButtonsCheckEvents() bitmask.
+ */
+typedef enum {
+    MORSE_CHANNEL_BTN1,
+    MORSE_CHANNEL_BTN2,
+    MORSE_CHANNEL_BTN3,
+    MORSE_CHANNEL_BTN4
+} MorseChannel;
+
+/**
+ * This enum lists the states of the timing state machine run by MorseDecoderCheckEvents().
+ */
+typedef enum {
+    MORSE_STATE_WAITING,       /// The button is up and no letter is in progress.
+    MORSE_STATE_DOT,           /// The button is down, not yet long enough for a DASH.
+    MORSE_STATE_DASH,          /// The button is down long enough for a DASH.
+    MORSE_STATE_INTER_LETTER,  /// The button is up after an element, before an INTER_LETTER.
+    MORSE_STATE_INTER_WORD     /// The button is up after an INTER_LETTER, before an INTER_WORD.
+} MorseState;
+
+/**
+ * A MorseDecoder holds all of the state for decoding one stream of Morse code: where decoding is
+ * within the Morse tree and where the timing state machine is for the button it listens to. Any
+ * number of these can be used side by side; the functions that take no decoder all operate on a
+ * single default decoder listening to BTN4. A decoder must be set up with MorseDecoderInit()
+ * before use and its members should be treated as private.
+ */
+typedef struct {
+    MorseChannel channel;
+    MorseState state;
+    uint16_t ticks;
+    uint8_t node;
+    uint8_t tolerant;
+    uint8_t confidence;
+    MorseTiming *timing;
+} MorseDecoder;
+
+/**
+ * This function initializes the Morse code decoder. The Morse tree, a binary tree consisting of all
+ * of the characters in MorseTable.h arranged according to the DOTs and DASHes that represent
+ * each character, is generated at compile time from MorseTable.h, so this only resets the decoding
+ * position to its root. Traversal of the tree is done by taking the left-child if it is a dot and
+ * the right-child if it is a dash. This function also initializes the Buttons library so that
+ * MorseCheckEvents() can work properly.
+ * @return SUCCESS, as the decoding tree no longer has to be created at runtime.
  */ 
 int MorseInit(void);
 
@@ -81,24 +125,173 @@ int MorseInit(void);
  */
 char MorseDecode(MorseChar in);
 
+/**
+ * The most DOTs and DASHes in any code that MorseDecode() and MorseDecodeSymbol() can decode.
+ */
+#define MORSE_SYMBOL_MAX_LENGTH 7
+
+/**
+ * MorseDecodeSymbol decodes a complete Morse symbol in a single table lookup, without touching the
+ * state used by MorseDecode(). The symbol is given as its number of elements and the elements
+ * themselves packed into bits, first element in the most-significant position, with a 1 for a
+ * DASH and a 0 for a DOT. So 'A' (.-) is MorseDecodeSymbol(2, 0x1) and '4' (....-) is
+ * MorseDecodeSymbol(5, 0x01). Prosigns decode to the characters given in MorseTable.h.
+ *
+ * @param length The number of DOTs and DASHes in the symbol, up to MORSE_SYMBOL_MAX_LENGTH.
+ * @param elements The DOTs and DASHes of the symbol packed as described above.
+ * @return The decoded character or STANDARD_ERROR if the symbol is too long, `elements` has bits
+ *         set above `length`, or the symbol doesn't represent a character.
+ */
+char MorseDecodeSymbol(uint8_t length, uint8_t elements);
+
+/**
+ * MorseDecodeString decodes a whole buffer of Morse code in one call, without touching the state
+ * used by MorseDecode(). The input is made of MORSE_CHAR_DOTs and MORSE_CHAR_DASHes, with each
+ * letter ended by a ' ' or a MORSE_CHAR_END_OF_CHAR ('#'), so "... --- ..." decodes to "SOS". A ' '
+ * that doesn't end a letter is a word space and is copied to the output, so ".- -...  -.-. "
+ * decodes to "AB C". A letter still in progress at the end of the input is decoded as well.
+ *
+ * Each letter's elements are accumulated straight into its packed code, which is only looked up
+ * once the letter ends, so every element only costs a shift and a bounds check.
+ *
+ * @param in The null-terminated Morse code to decode.
+ * @param out Where the null-terminated decoded text is stored.
+ * @param outLen How many chars fit in `out`, including the null terminator.
+ * @param errorPos If not NULL, where the index in `in` at which decoding stopped is stored when
+ *                 the result isn't SUCCESS. This is the start of the invalid letter, or of the
+ *                 letter or space that didn't fit.
+ * @return SUCCESS, STANDARD_ERROR if `in` contains a letter that doesn't decode or any other kind
+ *         of character, or SIZE_ERROR if `out` is too short. Everything decoded up to an error is
+ *         still stored in `out`.
+ */
+int MorseDecodeString(const char *in, char *out, int outLen, int *errorPos);
+
 /**
  * This function calls ButtonsCheckEvents() once per call and returns which, if any,
  * of the Morse code events listed in the enum above have been encountered. It checks for BTN4
- * events in its input and should be called at 100Hz so that the timing works. The
- * length that BTN4 needs to be held down for a dot is >= 0.25s and < 0.50s with a dash being a button
- * down event for >= 0.5s. The button uptime various between dots/dashes (>= .5s), letters
- * (>= 1s), and words (>= 2s).
+ * events in its input and should be called at 100Hz so that the timing works. A press shorter
+ * than MORSE_EVENT_LENGTH_DOWN_DASH (0.5s) is a DOT and any longer one a DASH, each reported as
+ * soon as the button is released. The button then has to stay up for
+ * MORSE_EVENT_LENGTH_UP_INTER_LETTER (1s) to end the letter and MORSE_EVENT_LENGTH_UP_INTER_WORD
+ * (2s) to end the word, both counted from the release.
  *
  * @note This function assumes that the buttons are all unpressed at startup, so that the first
  *       event it will see is a BUTTON_EVENT_*DOWN.
  *
- * So pressing the button for 0.1s, releasing it for 0.1s, pressing it for 0.3s, and then waiting
- * will decode the string '.-' (A). It will trigger the following order of events:
- * 9 MORSE_EVENT_NONEs, 1 MORSE_EVENT_DOT, 39 MORSE_EVENT_NONEs, a MORSE_EVENT_DASH, 69
- * MORSE_EVENT_NONEs, a MORSE_EVENT_END_CHAR, and then MORSE_EVENT_INTER_WORDs.
+ * So pressing the button for 0.3s, releasing it for 0.2s, pressing it for 0.6s, and then waiting
+ * will decode the string '.-' (A). Counting from the first press, it will trigger a
+ * MORSE_EVENT_DOT at 0.3s, a MORSE_EVENT_DASH at 1.1s, a MORSE_EVENT_INTER_LETTER at 2.1s and a
+ * MORSE_EVENT_INTER_WORD at 3.1s, with a MORSE_EVENT_NONE on every other tick.
  * 
  * @return The MorseEvent that occurred.
  */
 MorseEvent MorseCheckEvents(void);
 
+/**
+ * Prepares a MorseDecoder for use, resetting its decoding position and timing state machine. The
+ * Buttons library is not initialized by this, so either MorseInit() or ButtonsInit() must also be
+ * called before button events are passed to MorseDecoderCheckEvents().
+ *
+ * @param decoder The decoder to initialize.
+ * @param channel Which button the decoder listens to in MorseDecoderCheckEvents().
+ * @return SUCCESS or STANDARD_ERROR if `decoder` is NULL or `channel` isn't a valid MorseChannel.
+ */
+int MorseDecoderInit(MorseDecoder *decoder, MorseChannel channel);
+
+/**
+ * Selects how a decoder tells DOTs from DASHes and letters from words. By default a decoder uses
+ * the fixed lengths in MorseEventLength. Given a MorseTiming, it instead uses that timing's
+ * thresholds and adds every key-down time to it, so decoding follows the speed of the sender.
+ * The thresholds are read on every tick, so the timing can be swapped at any point in a stream.
+ *
+ * @param decoder A decoder that was set up with MorseDecoderInit().
+ * @param timing The adaptive timing to use, which must stay valid as long as the decoder is used,
+ *               or NULL to go back to the fixed lengths. One MorseTiming must not be shared by
+ *               several decoders.
+ */
+void MorseDecoderSetTiming(MorseDecoder *decoder, MorseTiming *timing);
+
+/**
+ * Works exactly like MorseDecode() but uses the decoding position stored in `decoder`.
+ *
+ * @param decoder A decoder that was set up with MorseDecoderInit().
+ * @param in A value from the MorseChar enum which specifies how to traverse the Morse tree.
+ * @return The same values as MorseDecode().
+ */
+char MorseDecoderDecode(MorseDecoder *decoder, MorseChar in);
+
+/**
+ * Turns error-tolerant decoding on or off for a decoder. When it is on, a symbol that doesn't
+ * decode to any character is instead decoded to the character whose code is the fewest element
+ * insertions, deletions or changes away from it, so an operator's dropped or extra element still
+ * gives the most likely letter instead of losing it. How sure that guess is can be read with
+ * MorseDecoderGetConfidence(). Symbols of more than MORSE_SYMBOL_MAX_LENGTH elements still can't
+ * be decoded.
+ *
+ * The nearest character for every possible symbol is worked out once, the first time any decoder
+ * turns this on, which takes a few milliseconds. Decoding then stays a single table lookup.
+ *
+ * @param decoder A decoder that was set up with MorseDecoderInit().
+ * @param tolerant TRUE to guess the nearest character, FALSE (the default) to return
+ *                 STANDARD_ERROR for symbols that don't decode.
+ */
+void MorseDecoderSetTolerant(MorseDecoder *decoder, int tolerant);
+
+/**
+ * Returns how sure the decoder is of the last character it decoded, as a percentage. An exact
+ * match is always 100. A guess made by error-tolerant decoding is 100 / (distance + 1), divided
+ * by how many characters were equally near, so a symbol one element away from exactly one
+ * character is 50.
+ *
+ * @param decoder A decoder that was set up with MorseDecoderInit().
+ * @return The confidence from 0 to 100, which is 0 if the last symbol didn't decode at all.
+ */
+uint8_t MorseDecoderGetConfidence(const MorseDecoder *decoder);
+
+/**
+ * Works exactly like MorseCheckEvents() but advances the state machine stored in `decoder` and
+ * takes the button events as an argument instead of calling ButtonsCheckEvents() itself. This lets
+ * a single ButtonsCheckEvents() call per tick drive several decoders, each of which only looks at
+ * the flags of its own button.
+ *
+ * @param decoder A decoder that was set up with MorseDecoderInit().
+ * @param buttonEvents The value returned by this tick's ButtonsCheckEvents() call.
+ * @return The MorseEvent that occurred.
+ */
+MorseEvent MorseDecoderCheckEvents(MorseDecoder *decoder, uint8_t buttonEvents);
+
+// The number of buttons, and so the most decoders, that MorseCheckChannelEvents() can handle.
+#define MORSE_NUM_CHANNELS 4
+
+/**
+ * Extracts the MorseEvent for one channel from the value returned by MorseCheckChannelEvents().
+ * Each channel's event is stored in its own 4-bit field, with BTN1 in the lowest bits.
+ */
+#define MORSE_CHANNEL_EVENT(events, channel) ((MorseEvent) (((events) >> (4 * (channel))) & 0xF))
+
+/**
+ * This function calls ButtonsCheckEvents() once per call and advances every given decoder with
+ * the resulting button events, so one 100Hz timer can decode up to MORSE_NUM_CHANNELS operators
+ * at once. Each decoder only looks at the flags of its own button, so presses and releases on
+ * different buttons during the same tick are all seen.
+ *
+ * Example usage for keying from all four buttons:
+ * MorseDecoder decoders[MORSE_NUM_CHANNELS];
+ * for (i = 0; i < MORSE_NUM_CHANNELS; ++i) {
+ *     MorseDecoderInit(&decoders[i], i);
+ * }
+ * ...
+ * uint16_t events = MorseCheckChannelEvents(decoders, MORSE_NUM_CHANNELS);
+ * if (MORSE_CHANNEL_EVENT(events, MORSE_CHANNEL_BTN2) == MORSE_EVENT_DOT) {
+ *     // A DOT was keyed on BTN2.
+ * }
+ *
+ * @param decoders An array of decoders that were set up with MorseDecoderInit(), each listening
+ *                 to a different channel.
+ * @param count How many decoders are in `decoders`, up to MORSE_NUM_CHANNELS.
+ * @return The MorseEvent of every decoder packed into the field for its channel, which can be read
+ *         with MORSE_CHANNEL_EVENT(). Channels without a decoder always hold MORSE_EVENT_NONE.
+ */
+uint16_t MorseCheckChannelEvents(MorseDecoder *decoders, int count);
+
 #endif // MORSE_H
@@ -0,0 +1,185 @@
+#include <stdint.h>
+#include <stddef.h>
+#include "MorseEncoder.h"
+#include "MorseTable.h"
+#include "BOARD.h"
+
+// Microchip libraries
+#include <xc.h>
+#include <plib.h>
+
+// The lengths of every part of a code, in units.
+#define MORSE_ENCODER_DOT_UNITS 1
+#define MORSE_ENCODER_DASH_UNITS 3
+#define MORSE_ENCODER_ELEMENT_GAP_UNITS 1
+#define MORSE_ENCODER_LETTER_GAP_UNITS 3
+#define MORSE_ENCODER_WORD_GAP_UNITS 7
+#define MORSE_ENCODER_UNITS_PER_WORD 50
+
+// Timer3 counts at PBCLK / 256.
+#define MORSE_ENCODER_PRESCALE 256
+#define MORSE_ENCODER_TIMER_MAX 0xFFFF
+
+// The code of every character, indexed by character and generated from MorseTable.h. Characters
+// without a code are 0, which is never a valid code.
+#define MORSE_ENCODER_ENTRY(c, length, elements) [c] = MORSE_CODE(length, elements),
+static const uint8_t codes[128] = {
+    MORSE_CODE_TABLE(MORSE_ENCODER_ENTRY)
+};
+
+// A code packs its elements below a marker bit in a byte, so it has at most this many.
+#define MORSE_ENCODER_MAX_ELEMENTS 7
+
+// The schedule of the character being sent alternates how many units the key is down and then
+// up, starting with down, so the entry being sent also tells which state the key is in. The next
+// character is scheduled once the gap after the last element of this one is over.
+static uint8_t schedule[2 * MORSE_ENCODER_MAX_ELEMENTS];
+static volatile int scheduleLength;
+static const char *message;
+static const char *next;
+static int repeatMessage;
+static volatile int position;
+static volatile uint8_t remaining;
+static volatile int busy;
+
+static int MorseEncoderSchedule(void);
+
+void MorseEncoderInit(void)
+{
+    MorseEncoderStop();
+    PORTSetPinsDigitalOut(MORSE_ENCODER_PORT, MORSE_ENCODER_BIT);
+    PORTClearBits(MORSE_ENCODER_PORT, MORSE_ENCODER_BIT);
+
+    // The key must flip right on time, so this gets the highest priority in use. It only ever
+    // counts down and flips a pin, so it never delays anything else noticeably.
+    INTSetVectorPriority(INT_TIMER_3_VECTOR, INT_PRIORITY_LEVEL_6);
+    INTSetVectorSubPriority(INT_TIMER_3_VECTOR, INT_SUB_PRIORITY_LEVEL_0);
+}
+
+int MorseEncodeChar(char c)
+{
+    if (c >= 'a' && c <= 'z') {
+        c -= 'a' - 'A';
+    }
+    if (c < 0 || codes[(uint8_t) c] == 0) {
+        return STANDARD_ERROR;
+    }
+    return codes[(uint8_t) c];
+}
+
+int MorseEncoderSend(const char *text, uint16_t wpm, int repeat)
+{
+    uint32_t unitCounts;
+    const char *c;
+
+    if (busy || wpm < MORSE_ENCODER_MIN_WPM || wpm > MORSE_ENCODER_MAX_WPM) {
+        return STANDARD_ERROR;
+    }
+    unitCounts = (60 * (BOARD_GetPBClock() / MORSE_ENCODER_PRESCALE)) /
+            (MORSE_ENCODER_UNITS_PER_WORD * wpm);
+    if (unitCounts > MORSE_ENCODER_TIMER_MAX) {
+        return STANDARD_ERROR;
+    }
+    for (c = text; *c != '\0' && MorseEncodeChar(*c) == STANDARD_ERROR; ++c);
+    if (*c == '\0') {
+        return STANDARD_ERROR;
+    }
+
+    message = text;
+    next = text;
+    repeatMessage = repeat;
+    scheduleLength = MorseEncoderSchedule();
+    position = 0;
+    remaining = schedule[0];
+    busy = TRUE;
+
+    PORTSetBits(MORSE_ENCODER_PORT, MORSE_ENCODER_BIT);
+    INTClearFlag(INT_T3);
+    OpenTimer3(T3_ON | T3_SOURCE_INT | T3_PS_1_256, unitCounts);
+    INTEnable(INT_T3, INT_ENABLED);
+    return SUCCESS;
+}
+
+void MorseEncoderStop(void)
+{
+    INTEnable(INT_T3, INT_DISABLED);
+    CloseTimer3();
+    INTClearFlag(INT_T3);
+    PORTClearBits(MORSE_ENCODER_PORT, MORSE_ENCODER_BIT);
+    busy = FALSE;
+}
+
+int MorseEncoderIsBusy(void)
+{
+    return busy ? TRUE : FALSE;
+}
+
+void __ISR(_TIMER_3_VECTOR, IPL6AUTO) MorseEncoderInterrupt(void)
+{
+    INTClearFlag(INT_T3);
+    if (--remaining > 0) {
+        return;
+    }
+
+    if (++position == scheduleLength) {
+        scheduleLength = MorseEncoderSchedule();
+        if (scheduleLength == 0) {
+            MorseEncoderStop();
+            return;
+        }
+        position = 0;
+    }
+    remaining = schedule[position];
+    if ((position & 1) == 0) {
+        PORTSetBits(MORSE_ENCODER_PORT, MORSE_ENCODER_BIT);
+    } else {
+        PORTClearBits(MORSE_ENCODER_PORT, MORSE_ENCODER_BIT);
+    }
+}
+
+/**
+ * Schedules the next character of the message with a code, starting over at the end of a repeated
+ * message, and returns how many entries it took or 0 once the message is done. The gap after it
+ * is widened into a word gap if a space or the end of the message comes before the next one.
+ */
+static int MorseEncoderSchedule(void)
+{
+    const char *c;
+    int length = 0;
+    int code;
+    int bit;
+
+    while ((code = MorseEncodeChar(*next)) == STANDARD_ERROR) {
+        if (*next != '\0') {
+            next++;
+        } else if (repeatMessage) {
+            next = message;
+        } else {
+            return 0;
+        }
+    }
+    next++;
+
+    // Walk the elements from the first, which is the bit right below the marker bit.
+    for (bit = 7; !(code & (1 << bit)); --bit);
+    for (--bit; bit >= 0; --bit) {
+        if (code & (1 << bit)) {
+            schedule[length++] = MORSE_ENCODER_DASH_UNITS;
+        } else {
+            schedule[length++] = MORSE_ENCODER_DOT_UNITS;
+        }
+        schedule[length++] = MORSE_ENCODER_ELEMENT_GAP_UNITS;
+    }
+
+    schedule[length - 1] = MORSE_ENCODER_LETTER_GAP_UNITS;
+    for (c = next; *c != '\0' && MorseEncodeChar(*c) == STANDARD_ERROR; ++c) {
+        if (*c == ' ') {
+            schedule[length - 1] = MORSE_ENCODER_WORD_GAP_UNITS;
+        }
+    }
+    if (*c == '\0') {
+        // A repeated message needs a word gap before it starts over.
+        schedule[length - 1] = MORSE_ENCODER_WORD_GAP_UNITS;
+    }
+    return length;
+}
@@ -0,0 +1,75 @@
+#ifndef MORSE_ENCODER_H
+#define MORSE_ENCODER_H
+
+/**
+ * @file
+ *
+ * This library sends text as Morse code by keying an output pin, such as an LED or a buzzer. The
+ * code for each character comes from a `const` table indexed by character, generated from the
+ * same MorseTable.h the decoder is built from, so encoding is always the exact inverse of decoding.
+ *
+ * Each character is turned into a schedule of how many units the key spends down and then up for
+ * each of its elements right before it is sent, so messages can be of any length. Timer3
+ * interrupts once per unit and only has to count down the current entry and flip the pin at its
+ * end, so every element is timed by the hardware to within the interrupt latency no matter what
+ * else the core is doing, including decoding. A message can also be repeated forever for use as a
+ * beacon.
+ *
+ * The pin is flipped in software since LD1 is on RE0, which isn't an output compare pin; those
+ * are only on RD0-RD4. At the highest interrupt priority in use the flip lands within a
+ * microsecond of the unit boundary, while a unit is at least 20ms long.
+ *
+ * Standard timing is used: a DOT is 1 unit, a DASH is 3, the gap between elements is 1 unit,
+ * between letters 3 and between words 7, with the speed in words per minute of the standard
+ * "PARIS" word of 50 units.
+ *
+ * Example usage for a beacon on the first LED:
+ * MorseEncoderInit();
+ * MorseEncoderSend("CQ CQ DE KJ6ABC", 20, TRUE);
+ */
+
+#include <stdint.h>
+
+// The pin that is driven high while the key is down. This is LD1 on the I/O shield.
+#define MORSE_ENCODER_PORT IOPORT_E
+#define MORSE_ENCODER_BIT BIT_0
+
+// The slowest and fastest speeds that can be sent.
+#define MORSE_ENCODER_MIN_WPM 2
+#define MORSE_ENCODER_MAX_WPM 60
+
+/**
+ * Configures the output pin and Timer3, and leaves the key up.
+ */
+void MorseEncoderInit(void);
+
+/**
+ * Looks up the Morse code of a character, ignoring case.
+ * @param c The character to look up.
+ * @return The code packed as by MORSE_CODE(), or STANDARD_ERROR if `c` has no code.
+ */
+int MorseEncodeChar(char c);
+
+/**
+ * Starts sending a message. Spaces separate words, and any other character without a code is
+ * skipped.
+ * @param text The null-terminated message, which is read as it is sent. It must not change until
+ *             sending is done or stopped.
+ * @param wpm The speed to send at, from MORSE_ENCODER_MIN_WPM to MORSE_ENCODER_MAX_WPM.
+ * @param repeat TRUE to keep sending the message, with a word gap in between, until stopped.
+ * @return SUCCESS or STANDARD_ERROR if a message is already being sent, `wpm` is out of range or
+ *         nothing in `text` can be sent.
+ */
+int MorseEncoderSend(const char *text, uint16_t wpm, int repeat);
+
+/**
+ * Stops sending right away and leaves the key up.
+ */
+void MorseEncoderStop(void);
+
+/**
+ * Returns TRUE while a message is being sent, FALSE otherwise.
+ */
+int MorseEncoderIsBusy(void);
+
+#endif // MORSE_ENCODER_H
@@ -0,0 +1,95 @@
+#ifndef MORSE_TABLE_H
+#define MORSE_TABLE_H
+
+/**
+ * @file
+ *
+ * This file holds the single definition of every character the Morse library knows about. All of
+ * the lookup tables used for decoding (and any used for encoding) are generated from this list by
+ * the preprocessor, so they are `const`, live in flash, and can never disagree with each other.
+ *
+ * The table covers the full ITU alphabet: letters, digits and punctuation, along with the common
+ * prosigns, which are sent as a single symbol and stand for a chosen character. The longest code
+ * ('$') has 7 elements.
+ *
+ * Each entry is written as X(character, length, elements) where `length` is the number of DOTs
+ * and DASHes in the code and `elements` stores them as bits, first element in the most-significant
+ * position, with a 1 for a DASH and a 0 for a DOT. So 'A' (.-) is X('A', 2, 0x1).
+ *
+ * Example usage for building a table indexed by code:
+ * #define ENTRY(c, length, elements) [MORSE_CODE(length, elements)] = c,
+ * const char table[64] = { MORSE_CODE_TABLE(ENTRY) };
+ */
+
+/**
+ * Packs a code into a single value by placing a 1 bit in front of the elements. This marks where
+ * the code starts, so codes of different lengths never collide, and it is also exactly the index
+ * of that code in a flat tree (@see TREE_ARRAY_ROOT) where DOTs take the left child and DASHes take
+ * the right one.
+ */
+#define MORSE_CODE(length, elements) ((1 << (length)) | (elements))
+
+// The characters that prosigns decode to. AR (end of message) and BT (break) are sent exactly like
+// '+' and '=', so they share them; SK (end of contact) has no character of its own.
+#define MORSE_PROSIGN_AR '+'
+#define MORSE_PROSIGN_BT '='
+#define MORSE_PROSIGN_SK '>'
+
+#define MORSE_CODE_TABLE(X) \
+    X('E', 1, 0x00) /* .     */ \
+    X('T', 1, 0x01) /* -     */ \
+    X('I', 2, 0x00) /* ..    */ \
+    X('A', 2, 0x01) /* .-    */ \
+    X('N', 2, 0x02) /* -.    */ \
+    X('M', 2, 0x03) /* --    */ \
+    X('S', 3, 0x00) /* ...   */ \
+    X('U', 3, 0x01) /* ..-   */ \
+    X('R', 3, 0x02) /* .-.   */ \
+    X('W', 3, 0x03) /* .--   */ \
+    X('D', 3, 0x04) /* -..   */ \
+    X('K', 3, 0x05) /* -.-   */ \
+    X('G', 3, 0x06) /* --.   */ \
+    X('O', 3, 0x07) /* ---   */ \
+    X('H', 4, 0x00) /* ....  */ \
+    X('V', 4, 0x01) /* ...-  */ \
+    X('F', 4, 0x02) /* ..-.  */ \
+    X('L', 4, 0x04) /* .-..  */ \
+    X('P', 4, 0x06) /* .--.  */ \
+    X('J', 4, 0x07) /* .---  */ \
+    X('B', 4, 0x08) /* -...  */ \
+    X('X', 4, 0x09) /* -..-  */ \
+    X('C', 4, 0x0A) /* -.-.  */ \
+    X('Y', 4, 0x0B) /* -.--  */ \
+    X('Z', 4, 0x0C) /* --..  */ \
+    X('Q', 4, 0x0D) /* --.-  */ \
+    X('5', 5, 0x00) /* ..... */ \
+    X('4', 5, 0x01) /* ....- */ \
+    X('3', 5, 0x03) /* ...-- */ \
+    X('2', 5, 0x07) /* ..--- */ \
+    X('1', 5, 0x0F) /* .---- */ \
+    X('6', 5, 0x10) /* -.... */ \
+    X('7', 5, 0x18) /* --... */ \
+    X('8', 5, 0x1C) /* ---.. */ \
+    X('9', 5, 0x1E) /* ----. */ \
+    X('0', 5, 0x1F) /* ----- */ \
+    X('&', 5, 0x08) /* .-... */ \
+    X(MORSE_PROSIGN_AR, 5, 0x0A) /* .-.-. */ \
+    X(MORSE_PROSIGN_BT, 5, 0x11) /* -...- */ \
+    X('/', 5, 0x12) /* -..-. */ \
+    X('(', 5, 0x16) /* -.--. */ \
+    X(MORSE_PROSIGN_SK, 6, 0x05) /* ...-.- */ \
+    X('?', 6, 0x0C) /* ..--.. */ \
+    X('_', 6, 0x0D) /* ..--.- */ \
+    X('"', 6, 0x12) /* .-..-. */ \
+    X('.', 6, 0x15) /* .-.-.- */ \
+    X('@', 6, 0x1A) /* .--.-. */ \
+    X('\'', 6, 0x1E) /* .----. */ \
+    X('-', 6, 0x21) /* -....- */ \
+    X(';', 6, 0x2A) /* -.-.-. */ \
+    X('!', 6, 0x2B) /* -.-.-- */ \
+    X(')', 6, 0x2D) /* -.--.- */ \
+    X(',', 6, 0x33) /* --..-- */ \
+    X(':', 6, 0x38) /* ---... */ \
+    X('$', 7, 0x09) /* ...-..- */
+
+#endif // MORSE_TABLE_H
@@ -0,0 +1,131 @@
+#include <stdint.h>
+#include "MorseTiming.h"
+
+// How many times the split between DOTs and DASHes is refined for each new press. The split is
+// kept above the shortest press, but a group can still come up empty (every press 0 ticks, say),
+// and then the presses are timed as a single group instead.
+#define MORSE_TIMING_ITERATIONS 3
+
+// A "PARIS" word is 50 units long, so there are (60 * ticksPerSecond) / (50 * unit) per minute.
+#define MORSE_TIMING_UNITS_PER_WORD 50
+
+static void MorseTimingSetUnit(MorseTiming *timing, uint32_t unit);
+static void MorseTimingSetAverage(MorseTiming *timing, uint32_t average);
+
+void MorseTimingInit(MorseTiming *timing, uint32_t unit, uint32_t ticksPerSecond)
+{
+    timing->ticksPerSecond = ticksPerSecond;
+    timing->count = 0;
+    timing->next = 0;
+    MorseTimingSetUnit(timing, unit);
+}
+
+void MorseTimingAddPress(MorseTiming *timing, uint32_t ticks)
+{
+    uint32_t sum = 0;
+    uint32_t low = ticks;
+    uint32_t high = ticks;
+    int i;
+
+    timing->presses[timing->next] = ticks;
+    if (++timing->next == MORSE_TIMING_HISTORY) {
+        timing->next = 0;
+    }
+    if (timing->count < MORSE_TIMING_HISTORY) {
+        timing->count++;
+    }
+    for (i = 0; i < timing->count; ++i) {
+        sum += timing->presses[i];
+        if (timing->presses[i] < low) {
+            low = timing->presses[i];
+        }
+        if (timing->presses[i] > high) {
+            high = timing->presses[i];
+        }
+    }
+
+    if (high < 2 * low) {
+        // Every press is about the same length, so they are all DOTs or all DASHes.
+        MorseTimingSetAverage(timing, sum / timing->count);
+    } else {
+        // Both DOTs and DASHes are present, so cluster them starting from the extremes. Each pass
+        // is only kept if it found both groups.
+        uint32_t split = (low + high) / 2;
+        uint32_t shortSum = 0;
+        uint32_t longSum = 0;
+        int shortCount = 0;
+        int longCount = 0;
+        int iteration;
+
+        for (iteration = 0; iteration < MORSE_TIMING_ITERATIONS; ++iteration) {
+            uint32_t passShortSum = 0;
+            uint32_t passLongSum = 0;
+            int passShortCount = 0;
+            int passLongCount = 0;
+            if (split <= low) {
+                split = low + 1;
+            }
+            for (i = 0; i < timing->count; ++i) {
+                if (timing->presses[i] < split) {
+                    passShortSum += timing->presses[i];
+                    passShortCount++;
+                } else {
+                    passLongSum += timing->presses[i];
+                    passLongCount++;
+                }
+            }
+            if (passShortCount == 0 || passLongCount == 0) {
+                break;
+            }
+            shortSum = passShortSum;
+            longSum = passLongSum;
+            shortCount = passShortCount;
+            longCount = passLongCount;
+            split = (shortSum / shortCount + longSum / longCount) / 2;
+        }
+
+        if (shortCount == 0) {
+            MorseTimingSetAverage(timing, sum / timing->count);
+        } else {
+            // A DOT is 1 unit and a DASH is 3, so both groups contribute to the estimate. The split
+            // only replaces the DASH threshold while it is above the unit, which it may not be if
+            // the unit was raised to the minimum.
+            MorseTimingSetUnit(timing, (shortSum + longSum) / (shortCount + 3 * longCount));
+            if (split > timing->unit) {
+                timing->dashThreshold = split;
+            }
+        }
+    }
+}
+
+uint16_t MorseTimingGetWpm(const MorseTiming *timing)
+{
+    return (60 * (uint64_t) timing->ticksPerSecond) / (MORSE_TIMING_UNITS_PER_WORD * timing->unit);
+}
+
+/**
+ * Sets the unit from the average of presses that are all DOTs or all DASHes. Whichever side of the
+ * current threshold the average falls on decides which.
+ */
+static void MorseTimingSetAverage(MorseTiming *timing, uint32_t average)
+{
+    if (average >= timing->dashThreshold) {
+        average /= 3;
+    }
+    MorseTimingSetUnit(timing, average);
+}
+
+/**
+ * Stores a new unit and derives the thresholds from it.
+ */
+static void MorseTimingSetUnit(MorseTiming *timing, uint32_t unit)
+{
+    uint32_t minimum = timing->ticksPerSecond / MORSE_TIMING_MIN_UNIT_DIVIDER;
+    if (unit < minimum || unit == 0) {
+        unit = minimum > 0 ? minimum : 1;
+    }
+    timing->unit = unit;
+    timing->dashThreshold = 2 * unit;
+    timing->letterThreshold = 2 * unit;
+    timing->wordThreshold = 5 * unit;
+}
@@ -0,0 +1,74 @@
+#ifndef MORSE_TIMING_H
+#define MORSE_TIMING_H
+
+/**
+ * @file
+ *
+ * This library estimates the speed of a Morse sender from how long they hold the key down, and
+ * derives the timing thresholds a decoder should use from that estimate. All times are in ticks
+ * of whatever clock drives the decoder, whose rate is given to MorseTimingInit(). For the 100Hz
+ * timer a tick is 0.01s; for edge timestamps from KeyCapture.h it's 1us.
+ *
+ * Standard Morse timing is built from a single unit, the length of a DOT: a DASH is 3 units, the
+ * gap between elements is 1 unit, between letters 3 units and between words 7 units. The last
+ * MORSE_TIMING_HISTORY key-down times are split into DOTs and DASHes with a 2-means clustering
+ * (repeatedly splitting halfway between the average short and average long press), and the unit is
+ * then estimated from both groups. Each threshold sits halfway between the two lengths it has to
+ * tell apart:
+ *   * DOT vs. DASH: 2 units of key-down time.
+ *   * element vs. letter gap: 2 units of key-up time.
+ *   * letter vs. word gap: 5 units of key-up time.
+ *
+ * Example usage with a decoder:
+ * MorseTiming timing;
+ * MorseTimingInit(&timing, MORSE_EVENT_LENGTH_DOWN_DOT, MORSE_TICKS_PER_SECOND);
+ * MorseDecoderSetTiming(&decoder, &timing);
+ */
+
+#include <stdint.h>
+
+// How many of the most recent key-down times the estimate is based on.
+#define MORSE_TIMING_HISTORY 8
+
+// The shortest unit that will be estimated, in 1/MORSE_TIMING_MIN_UNIT_DIVIDER of a second, to
+// keep the thresholds above the button debouncing. This is 0.02s, or 60 WPM.
+#define MORSE_TIMING_MIN_UNIT_DIVIDER 50
+
+/**
+ * The timing state for a single sender. The thresholds can be read directly but should only be
+ * changed through the functions below; all other members are private.
+ */
+typedef struct {
+    uint32_t presses[MORSE_TIMING_HISTORY];
+    uint8_t count;
+    uint8_t next;
+    uint32_t ticksPerSecond;
+    uint32_t unit;
+    uint32_t dashThreshold;
+    uint32_t letterThreshold;
+    uint32_t wordThreshold;
+} MorseTiming;
+
+/**
+ * Forgets all previous presses and restarts the estimate from a given unit.
+ * @param timing The timing state to initialize.
+ * @param unit The starting estimate for the length of a DOT in ticks.
+ * @param ticksPerSecond The rate of the clock all times are measured with.
+ */
+void MorseTimingInit(MorseTiming *timing, uint32_t unit, uint32_t ticksPerSecond);
+
+/**
+ * Adds how long the key was just held down to the history and updates the estimate and all
+ * thresholds.
+ * @param timing The timing state to update.
+ * @param ticks How long the key was held down.
+ */
+void MorseTimingAddPress(MorseTiming *timing, uint32_t ticks);
+
+/**
+ * Returns the current estimate of the sender's speed in words per minute, using the standard
+ * "PARIS" word of 50 units.
+ */
+uint16_t MorseTimingGetWpm(const MorseTiming *timing);
+
+#endif // MORSE_TIMING_H
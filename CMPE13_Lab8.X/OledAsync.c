@@ -0,0 +1,107 @@
+#include <stdint.h>
+#include <string.h>
+#include "OledAsync.h"
+#include "OledDriver.h"
+#include "BOARD.h"
+
+// Microchip libraries
+#include <xc.h>
+#include <plib.h>
+
+// SSD1306 commands sent before each page to start writing at its first column.
+#define OLED_ASYNC_CMD_SET_PAGE        0xB0
+#define OLED_ASYNC_CMD_SET_COLUMN_LOW  0x00
+#define OLED_ASYNC_CMD_SET_COLUMN_HIGH 0x10
+#define OLED_ASYNC_COMMANDS_PER_PAGE   3
+
+// The number of bytes sent for each page: its commands followed by its pixel data.
+#define OLED_ASYNC_BYTES_PER_PAGE (OLED_ASYNC_COMMANDS_PER_PAGE + OLED_DRIVER_PIXEL_COLUMNS)
+#define OLED_ASYNC_PAGES (OLED_DRIVER_PIXEL_ROWS / OLED_DRIVER_BUFFER_LINE_HEIGHT)
+
+// The snapshot being sent and how far into it the transfer is.
+static uint8_t frame[OLED_DRIVER_BUFFER_SIZE];
+static int page;
+static int position;
+static volatile int busy;
+static OledAsyncCallback doneCallback;
+
+static void OledAsyncSendNext(void);
+
+void OledAsyncInit(OledAsyncCallback callback)
+{
+    doneCallback = callback;
+
+    // Use a priority below the 100Hz timer so that a transfer never delays a tick.
+    INTEnable(INT_SPI2RX, INT_DISABLED);
+    INTClearFlag(INT_SPI2RX);
+    INTSetVectorPriority(INT_SPI_2_VECTOR, INT_PRIORITY_LEVEL_3);
+    INTSetVectorSubPriority(INT_SPI_2_VECTOR, INT_SUB_PRIORITY_LEVEL_0);
+}
+
+int OledAsyncUpdate(void)
+{
+    if (busy) {
+        return STANDARD_ERROR;
+    }
+    memcpy(frame, rgbOledBmp, sizeof (frame));
+    page = 0;
+    position = 0;
+    busy = TRUE;
+
+    // SPI2 is idle, so the first byte can be sent right away; the interrupt sends the rest.
+    INTClearFlag(INT_SPI2RX);
+    OledAsyncSendNext();
+    INTEnable(INT_SPI2RX, INT_ENABLED);
+    return SUCCESS;
+}
+
+int OledAsyncIsBusy(void)
+{
+    return busy ? TRUE : FALSE;
+}
+
+void __ISR(_SPI_2_VECTOR, IPL3AUTO) OledAsyncInterrupt(void)
+{
+    // Reading the received byte clears the receive-buffer-full condition.
+    (void) SPI2BUF;
+    INTClearFlag(INT_SPI2RX);
+
+    if (page < OLED_ASYNC_PAGES) {
+        OledAsyncSendNext();
+    } else {
+        INTEnable(INT_SPI2RX, INT_DISABLED);
+        busy = FALSE;
+        if (doneCallback != NULL) {
+            doneCallback();
+        }
+    }
+}
+
+/**
+ * Starts sending the next byte of the current page, switching the OLED between command and data
+ * mode right before the first byte of each. This is only called once the previous byte has been
+ * completely shifted out, so changing the mode pin never affects a byte in flight.
+ */
+static void OledAsyncSendNext(void)
+{
+    uint8_t data;
+    if (position == 0) {
+        PORTClearBits(OLED_DRIVER_MODE_PORT, OLED_DRIVER_MODE_BIT);
+        data = OLED_ASYNC_CMD_SET_PAGE | page;
+    } else if (position == 1) {
+        data = OLED_ASYNC_CMD_SET_COLUMN_LOW;
+    } else if (position == 2) {
+        data = OLED_ASYNC_CMD_SET_COLUMN_HIGH;
+    } else {
+        if (position == OLED_ASYNC_COMMANDS_PER_PAGE) {
+            PORTSetBits(OLED_DRIVER_MODE_PORT, OLED_DRIVER_MODE_BIT);
+        }
+        data = frame[page * OLED_DRIVER_PIXEL_COLUMNS + position - OLED_ASYNC_COMMANDS_PER_PAGE];
+    }
+
+    if (++position == OLED_ASYNC_BYTES_PER_PAGE) {
+        position = 0;
+        page++;
+    }
+    SPI2BUF = data;
+}
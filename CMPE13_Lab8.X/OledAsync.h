@@ -0,0 +1,58 @@
+#ifndef OLED_ASYNC_H
+#define OLED_ASYNC_H
+
+/**
+ * @file
+ *
+ * This library provides a non-blocking alternative to OledUpdate() / OledDriverUpdateDisplay().
+ * OledAsyncUpdate() takes a snapshot of `rgbOledBmp` into a second, private frame buffer and
+ * returns right away; the snapshot is then sent to the OLED one byte at a time from the SPI2
+ * interrupt. Because the snapshot is separate, the next frame can be drawn into `rgbOledBmp` with
+ * the usual Oled.h functions while the current one is still going out.
+ *
+ * The PIC32MX320F128H has no DMA controller, so the transfer is driven by the SPI2 receive
+ * interrupt, which fires once each byte has been completely shifted out. That is also the only
+ * safe point to switch the OLED between command and data mode between pages.
+ *
+ * While a transfer is in progress nothing else may use SPI2, so OledUpdate() must not be called
+ * until OledAsyncIsBusy() returns FALSE or the completion callback has run.
+ *
+ * Example usage:
+ * OledInit();
+ * OledAsyncInit(NULL);
+ * OledDrawString("Frame 1");
+ * OledAsyncUpdate();
+ * OledClear(OLED_COLOR_BLACK);
+ * OledDrawString("Frame 2"); // Safe, frame 1 is still being sent from its snapshot.
+ * while (OledAsyncIsBusy());
+ * OledAsyncUpdate();
+ */
+
+/**
+ * The type of function called when a transfer finishes. It is called from the SPI2 interrupt, so
+ * it should be short and may only start a new transfer with OledAsyncUpdate().
+ */
+typedef void (*OledAsyncCallback)(void);
+
+/**
+ * Sets up the SPI2 interrupt used for transfers. OledInit() must have been called first, as it
+ * configures SPI2 itself.
+ * @param callback The function to call when each transfer finishes, or NULL for none.
+ */
+void OledAsyncInit(OledAsyncCallback callback);
+
+/**
+ * Copies the current contents of `rgbOledBmp` and starts sending them to the OLED in the
+ * background.
+ * @return SUCCESS if the transfer was started or STANDARD_ERROR if one was already in progress, in
+ *         which case nothing is copied.
+ */
+int OledAsyncUpdate(void);
+
+/**
+ * Returns TRUE while a transfer started by OledAsyncUpdate() is still in progress and FALSE once
+ * the whole frame has been sent.
+ */
+int OledAsyncIsBusy(void);
+
+#endif // OLED_ASYNC_H
@@ -0,0 +1,225 @@
+#include <stdint.h>
+#include <string.h>
+#include "OledText.h"
+#include "Oled.h"
+#include "OledAsync.h"
+#include "OledDriver.h"
+#include "BOARD.h"
+
+// Microchip libraries
+#include <xc.h>
+#include <plib.h>
+
+// SSD1306 commands for selecting where in the page-addressed display RAM data will be written.
+#define OLED_TEXT_CMD_SET_PAGE        0xB0
+#define OLED_TEXT_CMD_SET_COLUMN_LOW  0x00
+#define OLED_TEXT_CMD_SET_COLUMN_HIGH 0x10
+
+// A text line must be exactly one page of the frame buffer and its dirty cells must fit in a word.
+typedef char OledTextCheckLineHeight[(ASCII_FONT_HEIGHT == OLED_DRIVER_BUFFER_LINE_HEIGHT) ? 1 : -1];
+typedef char OledTextCheckLineWidth[(OLED_CHARS_PER_LINE <= 32) ? 1 : -1];
+
+// The character in every cell and, per line, a bit for each cell that hasn't been drawn yet and a
+// bit for each cell that is drawn inverted.
+static char cells[OLED_NUM_LINES][OLED_CHARS_PER_LINE];
+static uint32_t dirty[OLED_NUM_LINES];
+static uint32_t inverse[OLED_NUM_LINES];
+
+// A bit per line whose whole page has moved in the frame buffer and must be sent again.
+static uint8_t moved;
+
+static uint8_t OledTextSpiPut(uint8_t data);
+static void OledTextSendColumns(int page, int column, int count);
+
+void OledTextInit(void)
+{
+    int line;
+    for (line = 0; line < OLED_NUM_LINES; ++line) {
+        OledTextClearLine(line);
+
+        // Mark everything dirty so the whole screen is sent, whatever the frame buffer held.
+        dirty[line] = (1UL << OLED_CHARS_PER_LINE) - 1;
+    }
+    OledTextUpdate();
+}
+
+int OledTextPutChar(int line, int column, char c)
+{
+    if (line < 0 || line >= OLED_NUM_LINES || column < 0 || column >= OLED_CHARS_PER_LINE) {
+        return STANDARD_ERROR;
+    }
+    if (cells[line][column] != c) {
+        cells[line][column] = c;
+        dirty[line] |= 1UL << column;
+    }
+    return SUCCESS;
+}
+
+int OledTextPutString(int line, int column, const char *string)
+{
+    int written = 0;
+    if (line < 0 || line >= OLED_NUM_LINES || column < 0 || column >= OLED_CHARS_PER_LINE) {
+        return SIZE_ERROR;
+    }
+    while (string[written] != '\0' && column + written < OLED_CHARS_PER_LINE) {
+        OledTextPutChar(line, column + written, string[written]);
+        written++;
+    }
+    return written;
+}
+
+int OledTextSetLine(int line, const char *string)
+{
+    int column = OledTextPutString(line, 0, string);
+    if (column < 0) {
+        return STANDARD_ERROR;
+    }
+    for (; column < OLED_CHARS_PER_LINE; ++column) {
+        OledTextPutChar(line, column, ' ');
+    }
+    return SUCCESS;
+}
+
+void OledTextClearLine(int line)
+{
+    int column;
+    OledTextSetInverted(line, 0, OLED_CHARS_PER_LINE, FALSE);
+    for (column = 0; column < OLED_CHARS_PER_LINE; ++column) {
+        OledTextPutChar(line, column, ' ');
+    }
+}
+
+int OledTextSetInverted(int line, int column, int count, int inverted)
+{
+    uint32_t mask;
+    if (line < 0 || line >= OLED_NUM_LINES || column < 0 || column >= OLED_CHARS_PER_LINE ||
+            count < 0) {
+        return STANDARD_ERROR;
+    }
+    if (count > OLED_CHARS_PER_LINE - column) {
+        count = OLED_CHARS_PER_LINE - column;
+    }
+    mask = ((1UL << count) - 1) << column;
+    if (inverted) {
+        dirty[line] |= mask & ~inverse[line];
+        inverse[line] |= mask;
+    } else {
+        dirty[line] |= mask & inverse[line];
+        inverse[line] &= ~mask;
+    }
+    return SUCCESS;
+}
+
+int OledTextIsInverted(int line, int column)
+{
+    if (line < 0 || line >= OLED_NUM_LINES || column < 0 || column >= OLED_CHARS_PER_LINE) {
+        return FALSE;
+    }
+    return (inverse[line] >> column) & 1;
+}
+
+int OledTextScrollUp(int firstLine, int lineCount)
+{
+    int line;
+    if (firstLine < 0 || lineCount < 1 || firstLine + lineCount > OLED_NUM_LINES) {
+        return STANDARD_ERROR;
+    }
+    for (line = firstLine; line < firstLine + lineCount - 1; ++line) {
+        memcpy(cells[line], cells[line + 1], OLED_CHARS_PER_LINE);
+        memcpy(&rgbOledBmp[line * OLED_DRIVER_PIXEL_COLUMNS],
+                &rgbOledBmp[(line + 1) * OLED_DRIVER_PIXEL_COLUMNS], OLED_DRIVER_PIXEL_COLUMNS);
+
+        // Cells that weren't drawn yet move with their characters and are drawn in their new place.
+        dirty[line] = dirty[line + 1];
+        inverse[line] = inverse[line + 1];
+        moved |= 1 << line;
+    }
+    OledTextClearLine(line);
+    return SUCCESS;
+}
+
+char OledTextGetChar(int line, int column)
+{
+    if (line < 0 || line >= OLED_NUM_LINES || column < 0 || column >= OLED_CHARS_PER_LINE) {
+        return '\0';
+    }
+    return cells[line][column];
+}
+
+int OledTextUpdate(void)
+{
+    int sent = 0;
+    int line;
+    for (line = 0; line < OLED_NUM_LINES; ++line) {
+        uint32_t lineDirty = dirty[line];
+        uint32_t lineInverse = inverse[line];
+        int first = -1;
+        int last = 0;
+        int column;
+        if (lineDirty == 0 && !(moved & (1 << line))) {
+            continue;
+        }
+
+        // Redraw each dirty cell, which is a straight copy since a line is exactly one page. An
+        // inverted cell XORs every byte with 0xFF instead of 0x00.
+        for (column = 0; column < OLED_CHARS_PER_LINE; ++column) {
+            if (lineDirty & (1UL << column)) {
+                const uint8_t *glyph = ascii[(uint8_t) cells[line][column]];
+                uint8_t *dest = &rgbOledBmp[line * OLED_DRIVER_PIXEL_COLUMNS +
+                        column * ASCII_FONT_WIDTH];
+                uint8_t invert = -((lineInverse >> column) & 1);
+                int i;
+                for (i = 0; i < ASCII_FONT_WIDTH; ++i) {
+                    dest[i] = glyph[i] ^ invert;
+                }
+                if (first < 0) {
+                    first = column;
+                }
+                last = column;
+            }
+        }
+        dirty[line] = 0;
+
+        // Send the whole page if it moved, otherwise one span covering every dirty cell.
+        if (moved & (1 << line)) {
+            first = 0;
+            last = OLED_CHARS_PER_LINE - 1;
+            moved &= ~(1 << line);
+        }
+        OledTextSendColumns(line, first * ASCII_FONT_WIDTH, (last - first + 1) * ASCII_FONT_WIDTH);
+        sent += (last - first + 1) * ASCII_FONT_WIDTH;
+    }
+    return sent;
+}
+
+/**
+ * Writes a byte out over the OLED's SPI channel and waits for the transfer to complete.
+ */
+static uint8_t OledTextSpiPut(uint8_t data)
+{
+    SPI2BUF = data;
+    while (!SPI2STATbits.SPIRBF);
+    return SPI2BUF;
+}
+
+/**
+ * Sends `count` bytes of one page of the frame buffer to the same place in the OLED's display RAM.
+ */
+static void OledTextSendColumns(int page, int column, int count)
+{
+    const uint8_t *data = &rgbOledBmp[page * OLED_DRIVER_PIXEL_COLUMNS + column];
+    int i;
+
+    // SPI2 can't be shared with a background frame transfer.
+    while (OledAsyncIsBusy());
+
+    PORTClearBits(OLED_DRIVER_MODE_PORT, OLED_DRIVER_MODE_BIT);
+    OledTextSpiPut(OLED_TEXT_CMD_SET_PAGE | page);
+    OledTextSpiPut(OLED_TEXT_CMD_SET_COLUMN_LOW | (column & 0x0F));
+    OledTextSpiPut(OLED_TEXT_CMD_SET_COLUMN_HIGH | (column >> 4));
+
+    PORTSetBits(OLED_DRIVER_MODE_PORT, OLED_DRIVER_MODE_BIT);
+    for (i = 0; i < count; ++i) {
+        OledTextSpiPut(data[i]);
+    }
+}
@@ -0,0 +1,122 @@
+#ifndef OLED_TEXT_H
+#define OLED_TEXT_H
+
+/**
+ * @file
+ *
+ * This library provides a text layer on top of Oled.h for screens that change a few characters at
+ * a time. The screen is treated as a grid of OLED_NUM_LINES by OLED_CHARS_PER_LINE character
+ * cells. Writing a cell only records the new character and marks it dirty if it changed; nothing
+ * is drawn until OledTextUpdate() is called.
+ *
+ * OledTextUpdate() then re-rasterizes only the dirty cells from the font in Ascii.h directly into
+ * the frame buffer and sends the OLED just the columns of each line that hold dirty cells. So
+ * appending one character to a line costs ASCII_FONT_WIDTH bytes of SPI traffic, instead of the
+ * whole OLED_DRIVER_BUFFER_SIZE bytes that OledUpdate() always sends.
+ *
+ * Each text line is exactly one page (8 pixel rows) of the frame buffer, and the font in Ascii.h
+ * already stores each glyph as one byte per pixel column in the same bit order as a page. Drawing
+ * a cell is therefore a straight copy of ASCII_FONT_WIDTH bytes, and redrawing the whole screen
+ * into the frame buffer takes a few microseconds; sending it over SPI is what takes time. A cell
+ * can also be inverted, drawing it black on white, to highlight it, which is just as fast since
+ * every byte of the glyph is XORed with the cell's mask on the way.
+ *
+ * Only whole cells are ever drawn. Mixing this library with OledDrawString() or OledSetPixel() on
+ * the same part of the screen is allowed, but OledUpdate() must then be used to show those changes.
+ *
+ * Example usage:
+ * OledInit();
+ * OledTextInit();
+ * OledTextPutString(0, 0, "Hello");
+ * OledTextUpdate(); // Sends 5 characters worth of columns.
+ * OledTextPutChar(0, 5, '!');
+ * OledTextUpdate(); // Sends 1 character worth of columns.
+ * OledTextSetInverted(0, 0, 5, TRUE);
+ * OledTextUpdate(); // Sends "Hello" again, highlighted.
+ */
+
+#include "Oled.h"
+
+/**
+ * Clears every cell to a space and sends the blank screen to the OLED. OledInit() must have been
+ * called first.
+ */
+void OledTextInit(void);
+
+/**
+ * Sets the character in a single cell, marking it dirty only if it changed.
+ * @param line Which text line to write, from 0 to OLED_NUM_LINES - 1.
+ * @param column Which cell of the line to write, from 0 to OLED_CHARS_PER_LINE - 1.
+ * @param c The character to show, using the glyphs defined in Ascii.h.
+ * @return SUCCESS or STANDARD_ERROR if the cell is off the screen.
+ */
+int OledTextPutChar(int line, int column, char c);
+
+/**
+ * Writes a string into consecutive cells of one line, starting at `column`. Writing stops at the
+ * end of the string or the end of the line, whichever comes first; there is no wrapping or newline
+ * processing.
+ * @param line Which text line to write, from 0 to OLED_NUM_LINES - 1.
+ * @param column The first cell to write, from 0 to OLED_CHARS_PER_LINE - 1.
+ * @param string A null-terminated string to write.
+ * @return The number of characters written, or SIZE_ERROR if the start is off the screen.
+ */
+int OledTextPutString(int line, int column, const char *string);
+
+/**
+ * Replaces the contents of a whole line with a string, padding the rest of the line with spaces.
+ * Only cells whose character actually changes are marked dirty, so rewriting a line with a string
+ * that only grew by one character only redraws that one cell.
+ * @param line Which text line to write, from 0 to OLED_NUM_LINES - 1.
+ * @param string A null-terminated string to write. Characters past the end of the line are ignored.
+ * @return SUCCESS or STANDARD_ERROR if the line is off the screen.
+ */
+int OledTextSetLine(int line, const char *string);
+
+/**
+ * Sets every cell of a line to a space that isn't inverted.
+ * @param line Which text line to clear, from 0 to OLED_NUM_LINES - 1.
+ */
+void OledTextClearLine(int line);
+
+/**
+ * Inverts or restores a run of cells on one line, marking dirty only the cells that change. The
+ * characters in the cells are kept, as is their inversion when they are written again.
+ * @param line Which text line to change, from 0 to OLED_NUM_LINES - 1.
+ * @param column The first cell to change, from 0 to OLED_CHARS_PER_LINE - 1.
+ * @param count How many cells to change. Cells past the end of the line are ignored.
+ * @param inverted TRUE to draw the cells black on white, FALSE for the normal white on black.
+ * @return SUCCESS or STANDARD_ERROR if the first cell is off the screen or `count` is negative.
+ */
+int OledTextSetInverted(int line, int column, int count, int inverted);
+
+/**
+ * Returns TRUE if a cell is inverted and FALSE if it isn't or is off the screen.
+ */
+int OledTextIsInverted(int line, int column);
+
+/**
+ * Returns the character currently stored in a cell, or '\0' if the cell is off the screen. This
+ * may not be what is shown yet if OledTextUpdate() hasn't been called since it was written.
+ */
+char OledTextGetChar(int line, int column);
+
+/**
+ * Scrolls a block of lines up by one line: every line takes on the contents of the one below it
+ * and the last line of the block is cleared. The frame buffer is shifted a page at a time rather
+ * than redrawn, so no glyphs are re-rasterized; the shifted lines are just sent again in full by
+ * the next OledTextUpdate().
+ * @param firstLine The top line of the block, which is scrolled off.
+ * @param lineCount How many lines the block spans.
+ * @return SUCCESS or STANDARD_ERROR if the block doesn't fit on the screen.
+ */
+int OledTextScrollUp(int firstLine, int lineCount);
+
+/**
+ * Draws every dirty cell into the frame buffer and sends the changed columns of each line to the
+ * OLED. Not calling this often enough only delays when changes show up; no writes are ever lost.
+ * @return The number of frame buffer bytes that were sent over SPI.
+ */
+int OledTextUpdate(void);
+
+#endif // OLED_TEXT_H
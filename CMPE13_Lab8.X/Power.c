@@ -0,0 +1,78 @@
+#include <stdint.h>
+#include "Power.h"
+#include "BOARD.h"
+
+// Microchip libraries
+#include <xc.h>
+#include <plib.h>
+
+// Core timer counts per microsecond, since the core timer counts at half the system clock.
+static uint32_t countsPerUs;
+
+// The idle and total time of the current measurement, in core timer counts. `lastTime` is when
+// the total was last brought up to date.
+static uint64_t idleCounts;
+static uint64_t totalCounts;
+static uint32_t lastTime;
+
+void PowerInit(void)
+{
+    countsPerUs = BOARD_GetSysClock() / 2 / 1000000;
+    idleCounts = 0;
+    totalCounts = 0;
+    lastTime = ReadCoreTimer();
+
+    // The compare interrupt only has to wake the core, so it gets the lowest priority.
+    INTEnable(INT_CT, INT_DISABLED);
+    INTClearFlag(INT_CT);
+    INTSetVectorPriority(INT_CORE_TIMER_VECTOR, INT_PRIORITY_LEVEL_1);
+    INTSetVectorSubPriority(INT_CORE_TIMER_VECTOR, INT_SUB_PRIORITY_LEVEL_0);
+}
+
+void PowerIdle(void)
+{
+    unsigned int status;
+    uint32_t start;
+    uint32_t end;
+
+    // An enabled interrupt still ends the wait with interrupts masked, but isn't handled until they
+    // are restored. So the wake is timestamped before the interrupt that caused it runs, and its
+    // handler isn't counted as idle.
+    status = INTDisableInterrupts();
+    start = ReadCoreTimer();
+    _CP0_SET_COMPARE(start + POWER_MAX_IDLE_US * countsPerUs);
+    INTClearFlag(INT_CT);
+    INTEnable(INT_CT, INT_ENABLED);
+    PowerSaveIdle();
+    end = ReadCoreTimer();
+    INTEnable(INT_CT, INT_DISABLED);
+    INTClearFlag(INT_CT);
+
+    totalCounts += end - lastTime;
+    idleCounts += end - start;
+    lastTime = end;
+    INTRestoreInterrupts(status);
+}
+
+uint16_t PowerGetIdlePermille(void)
+{
+    uint32_t now = ReadCoreTimer();
+    uint16_t permille = 0;
+
+    totalCounts += now - lastTime;
+    lastTime = now;
+    if (totalCounts > 0) {
+        permille = (idleCounts * 1000) / totalCounts;
+    }
+    idleCounts = 0;
+    totalCounts = 0;
+    return permille;
+}
+
+void __ISR(_CORE_TIMER_VECTOR, IPL1AUTO) PowerWakeInterrupt(void)
+{
+    // PowerIdle() normally disables and clears the compare before interrupts are restored, so this
+    // only runs if it matched right then. Waking the core was all it was for.
+    INTEnable(INT_CT, INT_DISABLED);
+    INTClearFlag(INT_CT);
+}
@@ -0,0 +1,56 @@
+#ifndef POWER_H
+#define POWER_H
+
+/**
+ * @file
+ *
+ * This library puts the core to sleep while there is nothing to do and measures how much of the
+ * time it spends that way. PowerIdle() stops the CPU in Idle mode until the next interrupt, which
+ * keeps the peripheral clock and with it the change-notice inputs, UART and timers running. It
+ * also keeps the core timer counting, which is what the time spent idle is measured with.
+ *
+ * The core timer wraps roughly every 107s, so a single stop is cut short after POWER_MAX_IDLE_US
+ * by a core timer compare interrupt. That keeps every idle period measurable no matter how long
+ * nothing happens, and only costs one extra wakeup every half minute.
+ *
+ * Interrupts are masked while the core is stopped. Any enabled interrupt still wakes it, but its
+ * handler only runs once the time of the wakeup has been taken, so handlers never count as idle.
+ *
+ * Only enabled interrupts wake the core, so anything that is only polled goes unseen while it is
+ * stopped. Of the buttons, only BTN2-BTN4 raise an interrupt of their own, through the
+ * change-notice inputs used by KeyCapture.h. BTN1 is on RF1, which has none, so lab8 never stops
+ * Timer2 while idle but only slows it to TICK_IDLE_RATE to keep polling BTN1.
+ *
+ * Example usage in a main loop:
+ * PowerInit();
+ * while (1) {
+ *     // Handle everything queued by interrupts.
+ *     PowerIdle();
+ * }
+ */
+
+#include <stdint.h>
+
+// The longest the core is stopped for by one call to PowerIdle().
+#define POWER_MAX_IDLE_US 30000000
+
+/**
+ * Starts measuring the idle fraction and sets up the core timer interrupt used to limit each stop.
+ */
+void PowerInit(void);
+
+/**
+ * Stops the core until any enabled interrupt occurs, or POWER_MAX_IDLE_US have passed, and adds
+ * the time it was stopped to the idle time. The interrupt that woke the core is handled right
+ * before this returns.
+ */
+void PowerIdle(void);
+
+/**
+ * Returns the fraction of the time that was spent in PowerIdle() since this was last called, or
+ * since PowerInit(), and starts measuring again.
+ * @return The idle fraction in thousandths, from 0 to 1000.
+ */
+uint16_t PowerGetIdlePermille(void);
+
+#endif // POWER_H
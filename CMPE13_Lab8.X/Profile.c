@@ -0,0 +1,119 @@
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include "Profile.h"
+#include "Uart.h"
+#include "BOARD.h"
+
+// Microchip libraries
+#include <xc.h>
+#include <plib.h>
+
+// The longest line a probe can take, which must fit the whole UART send buffer.
+#define PROFILE_LINE_SIZE 256
+typedef char ProfileCheckLineSize[(PROFILE_LINE_SIZE <= UART_TX_BUFFER_SIZE) ? 1 : -1];
+
+// The first histogram bucket covers everything below 2^PROFILE_FIRST_BUCKET_SHIFT counts.
+#define PROFILE_FIRST_BUCKET_SHIFT 6
+typedef char ProfileCheckFirstBucket[
+        (PROFILE_HISTOGRAM_FIRST_COUNTS == 1 << PROFILE_FIRST_BUCKET_SHIFT) ? 1 : -1];
+
+#define PROFILE_PROBE_NAME(probe, name) name,
+static const char *const probeNames[PROFILE_PROBE_COUNT] = {
+    PROFILE_PROBES(PROFILE_PROBE_NAME)
+};
+
+static ProfileStats stats[PROFILE_PROBE_COUNT];
+
+// The next probe to send, or PROFILE_PROBE_COUNT if no dump is being sent.
+static int dumpNext = PROFILE_PROBE_COUNT;
+
+static int ProfileFormat(ProfileProbe probe, char *line);
+
+void ProfileInit(void)
+{
+    unsigned int status = INTDisableInterrupts();
+    int probe;
+    memset(stats, 0, sizeof (stats));
+    for (probe = 0; probe < PROFILE_PROBE_COUNT; ++probe) {
+        stats[probe].min = UINT32_MAX;
+    }
+    INTRestoreInterrupts(status);
+}
+
+void ProfileRecord(ProfileProbe probe, uint32_t counts)
+{
+    ProfileStats *s = &stats[probe];
+    int bucket = 0;
+
+    // Bucket n > 0 holds counts from 2^(n + 5) up to 2^(n + 6), found from the highest set bit.
+    if (counts >= PROFILE_HISTOGRAM_FIRST_COUNTS) {
+        bucket = 31 - __builtin_clz(counts) - PROFILE_FIRST_BUCKET_SHIFT + 1;
+        if (bucket >= PROFILE_HISTOGRAM_BUCKETS) {
+            bucket = PROFILE_HISTOGRAM_BUCKETS - 1;
+        }
+    }
+    s->histogram[bucket]++;
+    s->runs++;
+    s->total += counts;
+    if (counts < s->min) {
+        s->min = counts;
+    }
+    if (counts > s->max) {
+        s->max = counts;
+    }
+}
+
+int ProfileGetStats(ProfileProbe probe, ProfileStats *copy)
+{
+    unsigned int status;
+    if (probe < 0 || probe >= PROFILE_PROBE_COUNT) {
+        return STANDARD_ERROR;
+    }
+    status = INTDisableInterrupts();
+    *copy = stats[probe];
+    INTRestoreInterrupts(status);
+    return SUCCESS;
+}
+
+void ProfileRequestDump(void)
+{
+    dumpNext = 0;
+}
+
+int ProfileSendDump(void)
+{
+    char line[PROFILE_LINE_SIZE];
+    while (dumpNext < PROFILE_PROBE_COUNT) {
+        int length = ProfileFormat(dumpNext, line);
+        if (UartGetTxSpace() < length) {
+            return TRUE;
+        }
+        UartWrite((const uint8_t *) line, length);
+        dumpNext++;
+    }
+    return FALSE;
+}
+
+/**
+ * Writes the dump line of a probe into `line`, which must hold PROFILE_LINE_SIZE chars, and
+ * returns its length.
+ */
+static int ProfileFormat(ProfileProbe probe, char *line)
+{
+    ProfileStats s;
+    int length;
+    int bucket;
+
+    ProfileGetStats(probe, &s);
+    length = snprintf(line, PROFILE_LINE_SIZE, "%s n=%lu min=%lu max=%lu mean=%lu hist=",
+            probeNames[probe], (unsigned long) s.runs,
+            (unsigned long) (s.runs > 0 ? s.min : 0), (unsigned long) s.max,
+            (unsigned long) (s.runs > 0 ? s.total / s.runs : 0));
+    for (bucket = 0; bucket < PROFILE_HISTOGRAM_BUCKETS; ++bucket) {
+        length += snprintf(&line[length], PROFILE_LINE_SIZE - length, "%s%lu",
+                bucket > 0 ? "," : "", (unsigned long) s.histogram[bucket]);
+    }
+    line[length++] = '\n';
+    return length;
+}
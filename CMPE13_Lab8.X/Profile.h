@@ -0,0 +1,123 @@
+#ifndef PROFILE_H
+#define PROFILE_H
+
+/**
+ * @file
+ *
+ * This library measures how long chosen stretches of code take, on the target, with the MIPS core
+ * timer (the CP0 Count register). Each stretch is a named probe, and every time it runs the count
+ * it took is added to that probe's statistics in RAM: how many times it ran, the shortest, the
+ * longest and the mean, and a histogram of the counts in power-of-two buckets. That shows both the
+ * typical cost of a probe and how often it is slow, which is what finds the cause of the rare
+ * tick that overruns.
+ *
+ * Reading the core timer is a single instruction, so a probe costs a few cycles plus the update of
+ * its statistics. Probes can be compiled out entirely by defining PROFILE_ENABLE as 0.
+ *
+ * The statistics are sent over the serial port as text on request, one line per probe, in core
+ * timer counts, which are PROFILE_COUNTS_PER_US to the microsecond:
+ *   tick n=1200 min=412 max=3911 mean=640 hist=0,0,0,12,1100,86,2,0,0,0,0,0,0,0,0,0
+ * Histogram bucket 0 counts the runs shorter than PROFILE_HISTOGRAM_FIRST_COUNTS and every bucket
+ * after that twice as many counts as the one before, with the last one taking everything longer.
+ *
+ * Every probe must only ever run at one interrupt priority, or in the main loop, since its
+ * statistics are updated without disabling interrupts.
+ *
+ * Example usage:
+ * PROFILE_BEGIN(PROFILE_PROBE_OLED_UPDATE);
+ * OledTextUpdate();
+ * PROFILE_END(PROFILE_PROBE_OLED_UPDATE);
+ */
+
+#include <stdint.h>
+#include <xc.h>
+
+#ifndef PROFILE_ENABLE
+#define PROFILE_ENABLE 1
+#endif
+
+// The core timer counts at half the 80MHz system clock.
+#define PROFILE_COUNTS_PER_US 40
+
+// The number of histogram buckets per probe, and the counts below which a run is in bucket 0.
+#define PROFILE_HISTOGRAM_BUCKETS 16
+#define PROFILE_HISTOGRAM_FIRST_COUNTS 64
+
+/**
+ * Lists every probe along with the name it is sent with.
+ */
+#define PROFILE_PROBES(X) \
+    X(PROFILE_PROBE_TICK, "tick")               /* All of the 100Hz timer interrupt. */ \
+    X(PROFILE_PROBE_BUTTONS, "buttons")         /* ButtonsCheckEvents() in the tick. */ \
+    X(PROFILE_PROBE_KEYER, "keyer")             /* KeyCaptureCheckEvents() in decodeTask(). */ \
+    X(PROFILE_PROBE_DRAW, "draw")               /* Drawing the symbol line in renderTask(). */ \
+    X(PROFILE_PROBE_OLED_UPDATE, "oledUpdate")  /* Sending a frame with OledTextUpdate(). */
+
+#define PROFILE_PROBE_ENUM(probe, name) probe,
+typedef enum {
+    PROFILE_PROBES(PROFILE_PROBE_ENUM)
+    PROFILE_PROBE_COUNT
+} ProfileProbe;
+
+/**
+ * The statistics of a single probe, all in core timer counts.
+ */
+typedef struct {
+    uint32_t runs;
+    uint32_t min;
+    uint32_t max;
+    uint64_t total;
+    uint32_t histogram[PROFILE_HISTOGRAM_BUCKETS];
+} ProfileStats;
+
+/**
+ * Starts timing a probe. Must be matched by a PROFILE_END() of the same probe in the same block,
+ * and declares a variable, so it can be used at most once per probe in a block.
+ */
+#define PROFILE_BEGIN(probe) \
+    uint32_t probe##_start = PROFILE_ENABLE ? _CP0_GET_COUNT() : 0
+
+/**
+ * Stops timing a probe and adds the run to its statistics.
+ */
+#define PROFILE_END(probe) do {                                 \
+    if (PROFILE_ENABLE) {                                       \
+        ProfileRecord((probe), _CP0_GET_COUNT() - probe##_start); \
+    }                                                           \
+} while (0)
+
+/**
+ * Clears the statistics of every probe.
+ */
+void ProfileInit(void);
+
+/**
+ * Adds one run to a probe's statistics. Should only be called through PROFILE_END().
+ * @param probe The ProfileProbe that ran.
+ * @param counts How many core timer counts it took.
+ */
+void ProfileRecord(ProfileProbe probe, uint32_t counts);
+
+/**
+ * Copies a probe's statistics as they are at one instant.
+ * @param probe The ProfileProbe to copy.
+ * @param stats Where the statistics are stored.
+ * @return SUCCESS or STANDARD_ERROR if `probe` isn't a probe.
+ */
+int ProfileGetStats(ProfileProbe probe, ProfileStats *stats);
+
+/**
+ * Starts sending the statistics of every probe, as they are when each line is sent. Starting again
+ * while a dump is being sent restarts it from the first probe.
+ */
+void ProfileRequestDump(void);
+
+/**
+ * Queues as many lines of a requested dump as the UART has room for, so a dump never blocks and
+ * never drops anything. Should be called from the main loop until it returns FALSE. UartInit()
+ * must have been called.
+ * @return TRUE if part of the dump is still waiting to be sent, FALSE otherwise.
+ */
+int ProfileSendDump(void);
+
+#endif // PROFILE_H
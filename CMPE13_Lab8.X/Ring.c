@@ -0,0 +1,49 @@
+#include <stddef.h>
+#include "Ring.h"
+#include "BOARD.h"
+
+int RingInit(Ring *ring, uint8_t *buffer, uint32_t size)
+{
+    if (ring == NULL || buffer == NULL || size == 0 || (size & (size - 1)) != 0) {
+        return STANDARD_ERROR;
+    }
+    ring->buffer = buffer;
+    ring->mask = size - 1;
+    ring->head = 0;
+    ring->tail = 0;
+    ring->overflows = 0;
+    return SUCCESS;
+}
+
+int RingPut(Ring *ring, uint8_t data)
+{
+    uint32_t head = ring->head;
+    if (head - ring->tail > ring->mask) {
+        ring->overflows++;
+        return STANDARD_ERROR;
+    }
+    ring->buffer[head & ring->mask] = data;
+
+    // The data must be stored before the consumer can see the new head, which holds because both
+    // are volatile accesses and so are never reordered by the compiler.
+    ring->head = head + 1;
+    return SUCCESS;
+}
+
+int RingGet(Ring *ring, uint8_t *data)
+{
+    uint32_t tail = ring->tail;
+    if (tail == ring->head) {
+        return STANDARD_ERROR;
+    }
+    *data = ring->buffer[tail & ring->mask];
+
+    // The data must be read before the producer is allowed to overwrite it.
+    ring->tail = tail + 1;
+    return SUCCESS;
+}
+
+uint32_t RingCount(const Ring *ring)
+{
+    return ring->head - ring->tail;
+}
@@ -0,0 +1,83 @@
+#ifndef RING_H
+#define RING_H
+
+/**
+ * @file
+ *
+ * This library implements a fixed-size ring buffer of bytes for passing data from exactly one
+ * producer to exactly one consumer, such as from an interrupt to the main loop. No locking or
+ * disabling of interrupts is needed: the producer only ever writes `head` and the consumer only
+ * ever writes `tail`, and each is a single aligned word so every write to it is atomic.
+ *
+ * The buffer size must be a power of two. `head` and `tail` count every byte that has ever been
+ * put or got and are masked when indexing the buffer, so the ring can hold all `size` bytes and
+ * the count of stored bytes is just `head - tail`, even after the counters wrap around.
+ *
+ * Example usage for a queue between an ISR and the main loop:
+ * static uint8_t queueBuffer[16];
+ * static Ring queue = RING_INITIALIZER(queueBuffer);
+ *
+ * // In the ISR:
+ * RingPut(&queue, data);
+ *
+ * // In the main loop:
+ * uint8_t data;
+ * while (RingGet(&queue, &data) == SUCCESS) {
+ *     // Handle data.
+ * }
+ */
+
+#include <stdint.h>
+
+/**
+ * A single-producer/single-consumer ring of bytes. Its members should be treated as private except
+ * for `overflows`, which counts every byte that RingPut() had to drop because the ring was full.
+ */
+typedef struct {
+    volatile uint8_t *buffer;
+    uint32_t mask;
+    volatile uint32_t head;
+    volatile uint32_t tail;
+    volatile uint32_t overflows;
+} Ring;
+
+/**
+ * Statically initializes an empty Ring using `buffer`, which must be an array (not a pointer)
+ * whose size is a power of two. This allows a Ring shared with an interrupt to be valid before
+ * that interrupt is ever enabled.
+ */
+#define RING_INITIALIZER(buffer) { (buffer), sizeof (buffer) - 1, 0, 0, 0 }
+
+/**
+ * Initializes an empty Ring at runtime.
+ * @param ring The ring to initialize.
+ * @param buffer Storage for the ring's data, which must stay valid as long as the ring is used.
+ * @param size The number of bytes in `buffer`. Must be a power of two.
+ * @return SUCCESS or STANDARD_ERROR if `size` isn't a power of two or any pointer is NULL.
+ */
+int RingInit(Ring *ring, uint8_t *buffer, uint32_t size);
+
+/**
+ * Adds a byte to the ring. Must only be called by the producer.
+ * @param ring The ring to add to.
+ * @param data The byte to add.
+ * @return SUCCESS or STANDARD_ERROR if the ring was full, in which case `data` is dropped and
+ *         counted in `ring->overflows`.
+ */
+int RingPut(Ring *ring, uint8_t data);
+
+/**
+ * Removes the oldest byte from the ring. Must only be called by the consumer.
+ * @param ring The ring to remove from.
+ * @param data Where the removed byte is stored.
+ * @return SUCCESS or STANDARD_ERROR if the ring was empty.
+ */
+int RingGet(Ring *ring, uint8_t *data);
+
+/**
+ * Returns how many bytes are currently stored in the ring. This is safe to call from either side,
+ * though the count may change right after it's read.
+ */
+uint32_t RingCount(const Ring *ring);
+
+#endif // RING_H
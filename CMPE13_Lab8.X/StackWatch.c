@@ -0,0 +1,38 @@
+#include <stdint.h>
+#include "StackWatch.h"
+
+// The lowest address the stack may grow down to and the address it starts from, both from the
+// linker script.
+extern uint32_t _splim[];
+extern uint32_t _stack[];
+
+// What an unused word of the stack holds. It is unlikely to be stored by any real code.
+#define STACK_WATCH_PATTERN 0x5AC3A55C
+
+// How many words just below the caller's locals are left alone, since the fill loop itself may
+// still use them.
+#define STACK_WATCH_MARGIN_WORDS 16
+
+void StackWatchInit(void)
+{
+    uint32_t marker;
+    uint32_t *end = &marker - STACK_WATCH_MARGIN_WORDS;
+    uint32_t *word;
+    for (word = _splim; word < end; ++word) {
+        *word = STACK_WATCH_PATTERN;
+    }
+}
+
+uint32_t StackWatchGetUsed(void)
+{
+    const uint32_t *word = _splim;
+    while (word < _stack && *word == STACK_WATCH_PATTERN) {
+        ++word;
+    }
+    return (_stack - word) * sizeof (uint32_t);
+}
+
+uint32_t StackWatchGetSize(void)
+{
+    return (_stack - _splim) * sizeof (uint32_t);
+}
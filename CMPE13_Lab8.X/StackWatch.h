@@ -0,0 +1,43 @@
+#ifndef STACK_WATCH_H
+#define STACK_WATCH_H
+
+/**
+ * @file
+ *
+ * This library measures the most stack that has ever been used, so that a board running close to
+ * overflowing it can be spotted while it runs. StackWatchInit() fills all of the stack below the
+ * caller with a pattern, and StackWatchGetUsed() later looks for the deepest word that no longer
+ * holds it. Interrupts run on the same stack, so their use is included.
+ *
+ * The stack is the memory between the _splim and _stack symbols of the XC32 linker script. Finding
+ * the high-water mark means reading every word that was never used, at most a few thousand, so it
+ * should be done now and then rather than in a loop.
+ *
+ * Example usage:
+ * int main(void)
+ * {
+ *     StackWatchInit();
+ *     ...
+ *     uint32_t used = StackWatchGetUsed();
+ * }
+ */
+
+#include <stdint.h>
+
+/**
+ * Fills the unused part of the stack with the pattern. Should be the first thing main() does, so
+ * that as much of the stack as possible is measured.
+ */
+void StackWatchInit(void);
+
+/**
+ * Returns how many bytes of the stack have been used at most since StackWatchInit().
+ */
+uint32_t StackWatchGetUsed(void);
+
+/**
+ * Returns how many bytes the stack can hold in total.
+ */
+uint32_t StackWatchGetSize(void);
+
+#endif // STACK_WATCH_H
@@ -0,0 +1,51 @@
+#include <stdint.h>
+#include "TextLine.h"
+
+void TextLineClear(TextLine *line)
+{
+    line->start = 0;
+    line->length = 0;
+}
+
+void TextLineAppend(TextLine *line, char c)
+{
+    int end = line->start + line->length;
+    if (end >= TEXT_LINE_LENGTH) {
+        end -= TEXT_LINE_LENGTH;
+    }
+    line->text[end] = c;
+
+    // A full line scrolls by overwriting its oldest character and moving the start past it.
+    if (line->length < TEXT_LINE_LENGTH) {
+        line->length++;
+    } else if (++line->start == TEXT_LINE_LENGTH) {
+        line->start = 0;
+    }
+}
+
+int TextLineLength(const TextLine *line)
+{
+    return line->length;
+}
+
+char TextLineGetChar(const TextLine *line, int index)
+{
+    if (index < 0 || index >= line->length) {
+        return '\0';
+    }
+    index += line->start;
+    if (index >= TEXT_LINE_LENGTH) {
+        index -= TEXT_LINE_LENGTH;
+    }
+    return line->text[index];
+}
+
+int TextLineCopy(const TextLine *line, char *string)
+{
+    int i;
+    for (i = 0; i < line->length; ++i) {
+        string[i] = TextLineGetChar(line, i);
+    }
+    string[i] = '\0';
+    return i;
+}
@@ -0,0 +1,73 @@
+#ifndef TEXT_LINE_H
+#define TEXT_LINE_H
+
+/**
+ * @file
+ *
+ * This library implements a fixed-capacity line of text sized to one line of the OLED. Appending a
+ * character and clearing the line both take constant time, and no memory is ever allocated. Once
+ * the line holds TEXT_LINE_LENGTH characters, appending another drops the oldest one, so the text
+ * scrolls to the left and always shows the most recent characters.
+ *
+ * Internally the characters are stored as a ring, so the text isn't contiguous in memory or
+ * null-terminated. Use TextLineCopy() to get it as a string, such as for drawing it.
+ *
+ * Example usage:
+ * TextLine line;
+ * char string[TEXT_LINE_LENGTH + 1];
+ * TextLineClear(&line);
+ * TextLineAppend(&line, 'H');
+ * TextLineAppend(&line, 'I');
+ * TextLineCopy(&line, string); // string is now "HI"
+ */
+
+#include <stdint.h>
+#include "Oled.h"
+
+// The most characters a TextLine holds, which is exactly as many as fit on a line of the OLED.
+#define TEXT_LINE_LENGTH OLED_CHARS_PER_LINE
+
+/**
+ * A single line of text. Its members should be treated as private.
+ */
+typedef struct {
+    char text[TEXT_LINE_LENGTH];
+    uint8_t start;
+    uint8_t length;
+} TextLine;
+
+/**
+ * Empties a line. This must be done before a TextLine is used for the first time.
+ * @param line The line to clear.
+ */
+void TextLineClear(TextLine *line);
+
+/**
+ * Adds a character to the end of a line, dropping the first character if the line was full.
+ * @param line The line to append to.
+ * @param c The character to append.
+ */
+void TextLineAppend(TextLine *line, char c);
+
+/**
+ * Returns the number of characters currently stored in a line.
+ */
+int TextLineLength(const TextLine *line);
+
+/**
+ * Returns a character from a line, where index 0 is the oldest character still stored.
+ * @param line The line to read from.
+ * @param index Which character to read, from 0 to TextLineLength() - 1.
+ * @return The character or '\0' if `index` is out of range.
+ */
+char TextLineGetChar(const TextLine *line, int index);
+
+/**
+ * Copies the contents of a line out as a null-terminated string.
+ * @param line The line to copy.
+ * @param string Where to store the string. Must hold at least TEXT_LINE_LENGTH + 1 chars.
+ * @return The number of characters copied, not counting the terminating '\0'.
+ */
+int TextLineCopy(const TextLine *line, char *string);
+
+#endif // TEXT_LINE_H
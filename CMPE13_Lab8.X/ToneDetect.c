@@ -0,0 +1,198 @@
+#include <stdint.h>
+#include "ToneDetect.h"
+#include "KeyCapture.h"
+#include "BOARD.h"
+
+// Microchip libraries
+#include <xc.h>
+#include <plib.h>
+
+// The audio is on AN4, with the pin on RB4.
+#define TONE_DETECT_CHANNEL 4
+#define TONE_DETECT_PIN BIT_4
+
+// Sampling takes 15 TAD and converting 12 more, with TAD = 2 * (1 + 1) PBCLK cycles = 200ns, so a
+// conversion is done in under 6us and always long before the next sample.
+#define TONE_DETECT_AD1CON3 ((15 << _AD1CON3_SAMC_POSITION) | (1 << _AD1CON3_ADCS_POSITION))
+
+// Integer results, converted automatically once sampling ends; sampling is started by hand.
+#define TONE_DETECT_AD1CON1 (7 << _AD1CON1_SSRC_POSITION)
+
+// The Goertzel coefficient is stored with this many fraction bits. With 10-bit samples the filter
+// state stays below 2^18, so the product with a coefficient of at most 2^13 fits in 32 bits.
+#define TONE_DETECT_COEFFICIENT_BITS 12
+
+// The mid-scale reading that the samples are measured from until the first block has been seen.
+#define TONE_DETECT_MID_SCALE 512
+
+static volatile int32_t coefficient;
+static volatile int32_t nextCoefficient;
+static volatile uint16_t tunedPitch;
+static volatile uint8_t keyed;
+static uint8_t running;
+
+// The Goertzel filter state and the sum and energy of the samples of the current block.
+static int32_t s1;
+static int32_t s2;
+static int32_t sum;
+static uint32_t energy;
+static int count;
+static int32_t offset = TONE_DETECT_MID_SCALE;
+
+static int32_t ToneDetectCoefficient(uint16_t pitch);
+static void ToneDetectEndBlock(void);
+
+int ToneDetectInit(uint16_t pitch)
+{
+    if (ToneDetectSetPitch(pitch) != SUCCESS) {
+        return STANDARD_ERROR;
+    }
+    coefficient = nextCoefficient;
+    keyed = FALSE;
+    s1 = 0;
+    s2 = 0;
+    sum = 0;
+    energy = 0;
+    count = 0;
+
+    AD1CON1 = 0;
+    AD1PCFGCLR = TONE_DETECT_PIN;
+    PORTSetPinsAnalogIn(IOPORT_B, TONE_DETECT_PIN);
+    AD1CHS = TONE_DETECT_CHANNEL << _AD1CHS_CH0SA_POSITION;
+    AD1CON2 = 0;
+    AD1CON3 = TONE_DETECT_AD1CON3;
+    AD1CON1 = TONE_DETECT_AD1CON1;
+    AD1CON1SET = _AD1CON1_ON_MASK;
+    AD1CON1SET = _AD1CON1_SAMP_MASK;
+
+    // Edges must be put at the change-notice priority, and the sampling itself is short enough not
+    // to hold up edges from the buttons.
+    OpenTimer4(T4_ON | T4_SOURCE_INT | T4_PS_1_1, BOARD_GetPBClock() / TONE_DETECT_SAMPLE_RATE);
+    INTClearFlag(INT_T4);
+    INTSetVectorPriority(INT_TIMER_4_VECTOR, INT_PRIORITY_LEVEL_5);
+    INTSetVectorSubPriority(INT_TIMER_4_VECTOR, INT_SUB_PRIORITY_LEVEL_1);
+    INTEnable(INT_T4, INT_ENABLED);
+    running = TRUE;
+    return SUCCESS;
+}
+
+void ToneDetectStop(void)
+{
+    // With every interrupt masked the last edge can be put just as from the change-notice priority.
+    unsigned int status;
+    if (!running) {
+        return;
+    }
+    status = INTDisableInterrupts();
+    INTEnable(INT_T4, INT_DISABLED);
+    T4CONCLR = _T4CON_ON_MASK;
+    INTClearFlag(INT_T4);
+    AD1CON1CLR = _AD1CON1_ON_MASK;
+    if (keyed) {
+        keyed = FALSE;
+        KeyCapturePutEdge(ReadCoreTimer(), FALSE);
+    }
+    running = FALSE;
+    INTRestoreInterrupts(status);
+}
+
+int ToneDetectIsRunning(void)
+{
+    return running ? TRUE : FALSE;
+}
+
+int ToneDetectSetPitch(uint16_t pitch)
+{
+    if (pitch < TONE_DETECT_MIN_PITCH || pitch > TONE_DETECT_MAX_PITCH) {
+        return STANDARD_ERROR;
+    }
+    nextCoefficient = ToneDetectCoefficient(pitch);
+    tunedPitch = pitch;
+    return SUCCESS;
+}
+
+uint16_t ToneDetectGetPitch(void)
+{
+    return tunedPitch;
+}
+
+int ToneDetectIsKeyed(void)
+{
+    return keyed ? TRUE : FALSE;
+}
+
+void __ISR(_TIMER_4_VECTOR, IPL5AUTO) ToneDetectInterrupt(void)
+{
+    int32_t sample;
+    int32_t s;
+
+    INTClearFlag(INT_T4);
+
+    // The conversion started by the previous interrupt has long finished.
+    sample = ADC1BUF0;
+    AD1CON1SET = _AD1CON1_SAMP_MASK;
+
+    sum += sample;
+    sample -= offset;
+    energy += sample * sample;
+    s = sample + ((coefficient * s1) >> TONE_DETECT_COEFFICIENT_BITS) - s2;
+    s2 = s1;
+    s1 = s;
+    if (++count == TONE_DETECT_BLOCK_SIZE) {
+        ToneDetectEndBlock();
+    }
+}
+
+/**
+ * Returns 2 * cos(2 * pi * pitch / TONE_DETECT_SAMPLE_RATE) with TONE_DETECT_COEFFICIENT_BITS
+ * fraction bits. The angle is at most about 1.2 radians, where the Taylor series is accurate to
+ * far better than the coefficient's precision after a handful of terms, so no math library is
+ * needed.
+ */
+static int32_t ToneDetectCoefficient(uint16_t pitch)
+{
+    const double pi = 3.14159265358979323846;
+    double angle = 2 * pi * pitch / TONE_DETECT_SAMPLE_RATE;
+    double term = 1;
+    double cosine = 1;
+    int i;
+
+    for (i = 1; i <= 8; ++i) {
+        term *= -angle * angle / ((2 * i - 1) * (2 * i));
+        cosine += term;
+    }
+    return (int32_t) (2 * cosine * (1 << TONE_DETECT_COEFFICIENT_BITS) + 0.5);
+}
+
+/**
+ * Decides whether the block that just ended held the tone, puts an edge if that changed, and
+ * starts the next block.
+ */
+static void ToneDetectEndBlock(void)
+{
+    // The power in the bin, which for a pure tone at the pitch is N / 2 times the block's energy.
+    int64_t power = (int64_t) s1 * s1 + (int64_t) s2 * s2 -
+            (((int64_t) coefficient * s1 * s2) >> TONE_DETECT_COEFFICIENT_BITS);
+    int64_t pureTone = (int64_t) energy * (TONE_DETECT_BLOCK_SIZE / 2);
+    uint8_t heard = keyed;
+
+    if (!keyed && energy >= (uint32_t) TONE_DETECT_SQUELCH * TONE_DETECT_BLOCK_SIZE &&
+            2 * power >= pureTone) {
+        heard = TRUE;
+    } else if (keyed && 4 * power < pureTone) {
+        heard = FALSE;
+    }
+    if (heard != keyed) {
+        keyed = heard;
+        KeyCapturePutEdge(ReadCoreTimer(), heard);
+    }
+
+    // The next block is measured from the average of this one, which tracks the input's bias.
+    offset = sum / TONE_DETECT_BLOCK_SIZE;
+    coefficient = nextCoefficient;
+    s1 = 0;
+    s2 = 0;
+    sum = 0;
+    energy = 0;
+    count = 0;
+}
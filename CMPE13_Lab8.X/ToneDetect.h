@@ -0,0 +1,97 @@
+#ifndef TONE_DETECT_H
+#define TONE_DETECT_H
+
+/**
+ * @file
+ *
+ * This library receives Morse code from audio, such as the speaker output of a receiver, instead of
+ * from a hand key. Timer4 samples the A/D converter at TONE_DETECT_SAMPLE_RATE, and each block of
+ * TONE_DETECT_BLOCK_SIZE samples is run through a fixed-point Goertzel filter tuned to the pitch
+ * of the CW tone. Each time the tone comes or goes, an edge is put on KEY_CAPTURE_CHANNEL_TONE, so
+ * a KeyCaptureKeyer on that channel turns the audio into the same MorseEvents as a button.
+ *
+ * The Goertzel filter is a single-bin DFT that costs one multiply and two adds per sample, plus a
+ * multiply and an add to sum up the block's energy, with the power in the bin computed once per
+ * block. That power is compared against the energy of the whole
+ * block, so the decision doesn't depend on the volume: a pure tone at the pitch puts all of its
+ * energy in the bin, while noise spreads its energy evenly. A block keys down once the bin holds
+ * at least half of what a pure tone would, and up again once it's below a quarter, and blocks
+ * quieter than TONE_DETECT_SQUELCH never key down. All of it runs in the sampling interrupt, which
+ * takes about 1% of the CPU but also wakes the core every 125us, so detection should only be
+ * started while there is audio to decode and stopped again with ToneDetectStop() after.
+ *
+ * Blocks are 10ms long, which sets the bandwidth of the filter: it keys on tones within about 40Hz
+ * of the pitch, and edges are timed to within a block, like with the 100Hz button polling.
+ *
+ * The audio goes to A1 on the Uno32 (AN4, RB4) and must be biased to the middle of the 0-3.3V
+ * range, such as through a capacitor into a divider.
+ *
+ * Example usage for decoding a 700Hz tone:
+ * static KeyCaptureKeyer toneKeyer;
+ * KeyCaptureInit(NULL);
+ * KeyCaptureKeyerInit(&toneKeyer, KEY_CAPTURE_CHANNEL_TONE);
+ * ToneDetectInit(700);
+ *
+ * // In the 100Hz ISR:
+ * MorseEvent event = KeyCaptureCheckEvents(&toneKeyer);
+ *
+ * // Once done listening:
+ * ToneDetectStop();
+ */
+
+#include <stdint.h>
+
+// How often the audio is sampled, and how many samples each tone decision is made from.
+#define TONE_DETECT_SAMPLE_RATE 8000
+#define TONE_DETECT_BLOCK_SIZE 80
+
+// The lowest and highest pitches that can be detected, in Hz, and a common default.
+#define TONE_DETECT_MIN_PITCH 300
+#define TONE_DETECT_MAX_PITCH 1500
+#define TONE_DETECT_DEFAULT_PITCH 700
+
+// The mean square level, in A/D counts squared, that a block must reach to key down.
+#define TONE_DETECT_SQUELCH 16
+
+// The unit, in microseconds, that the timing of a tone keyer should start out from. That is 20WPM,
+// which is common on the air, and the timing adapts from there.
+#define TONE_DETECT_INITIAL_UNIT_US 60000
+
+/**
+ * Configures the A/D converter and starts sampling and detecting. KeyCaptureInit() must have been
+ * called first, since edges are put as soon as the tone is heard.
+ * @param pitch The pitch of the tone in Hz, from TONE_DETECT_MIN_PITCH to TONE_DETECT_MAX_PITCH.
+ * @return SUCCESS or STANDARD_ERROR if `pitch` is out of range, in which case nothing is started.
+ */
+int ToneDetectInit(uint16_t pitch);
+
+/**
+ * Stops sampling and turns off Timer4 and the A/D converter. If the tone was being heard, a key-up
+ * edge is put so the keyer isn't left with the key down. Can be called from the main loop, and
+ * does nothing if detection isn't running.
+ */
+void ToneDetectStop(void);
+
+/**
+ * Returns TRUE between ToneDetectInit() and ToneDetectStop(), FALSE otherwise.
+ */
+int ToneDetectIsRunning(void);
+
+/**
+ * Retunes the filter, starting with the next block.
+ * @param pitch The new pitch in Hz, from TONE_DETECT_MIN_PITCH to TONE_DETECT_MAX_PITCH.
+ * @return SUCCESS or STANDARD_ERROR if `pitch` is out of range, in which case it isn't changed.
+ */
+int ToneDetectSetPitch(uint16_t pitch);
+
+/**
+ * Returns the pitch the filter is tuned to, in Hz.
+ */
+uint16_t ToneDetectGetPitch(void);
+
+/**
+ * Returns TRUE while the tone is being heard, FALSE otherwise.
+ */
+int ToneDetectIsKeyed(void);
+
+#endif // TONE_DETECT_H
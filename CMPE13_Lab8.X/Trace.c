@@ -0,0 +1,39 @@
+#include <stdint.h>
+#include "Trace.h"
+#include "Uart.h"
+#include "BOARD.h"
+
+// Microchip libraries
+#include <xc.h>
+#include <plib.h>
+
+static volatile uint8_t enabled;
+
+void TraceSetEnabled(int enable)
+{
+    enabled = enable ? TRUE : FALSE;
+}
+
+int TraceIsEnabled(void)
+{
+    return enabled;
+}
+
+void TraceWrite(TraceId id, uint16_t value)
+{
+    uint32_t time = ReadCoreTimer();
+    uint8_t record[TRACE_RECORD_SIZE];
+
+    if (!enabled) {
+        return;
+    }
+    record[0] = TRACE_SYNC;
+    record[1] = id;
+    record[2] = time & 0xFF;
+    record[3] = (time >> 8) & 0xFF;
+    record[4] = (time >> 16) & 0xFF;
+    record[5] = time >> 24;
+    record[6] = value & 0xFF;
+    record[7] = value >> 8;
+    UartWrite(record, sizeof (record));
+}
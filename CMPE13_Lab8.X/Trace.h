@@ -0,0 +1,78 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+/**
+ * @file
+ *
+ * This library writes compact binary trace records for diagnostics over the serial port, without
+ * the cost of formatting and sending text. Each record is TRACE_RECORD_SIZE bytes:
+ *   * TRACE_SYNC, to find the start of a record.
+ *   * The TraceId saying what the record is about.
+ *   * When it was written, in core timer counts at 40MHz, as 32 bits little-endian. This wraps
+ *     every 107s, so a reader can unwrap it as long as records are closer together than that.
+ *   * A value that depends on the TraceId, as 16 bits little-endian.
+ *
+ * Records aren't escaped, so they can't be told apart from other bytes sent over the serial port.
+ * Tracing is therefore off until TraceSetEnabled() turns it on, and while it is on nothing else
+ * may be sent; lab8 stops its text output while tracing. A reader finds the first record by its
+ * TRACE_SYNC and checks that every TRACE_RECORD_SIZE bytes after that start with one too.
+ *
+ * Records are queued with UartWrite(), so writing one only takes a few microseconds and is safe
+ * from any interrupt; UartInit() must have been called for them to actually be sent. Tracing can
+ * be compiled out entirely by defining TRACE_ENABLE as 0.
+ *
+ * Example usage:
+ * TraceSetEnabled(TRUE);
+ * TRACE(TRACE_ID_EDGE_DOWN, MORSE_CHANNEL_BTN4);
+ */
+
+#include <stdint.h>
+
+#ifndef TRACE_ENABLE
+#define TRACE_ENABLE 1
+#endif
+
+// The first byte of every record.
+#define TRACE_SYNC 0xA5
+
+// The number of bytes in every record.
+#define TRACE_RECORD_SIZE 8
+
+/**
+ * This enum lists what each trace record can be about, along with what its value holds.
+ */
+typedef enum {
+    TRACE_ID_EDGE_DOWN = 1,  /// KeyCapture queued a key-down edge. The value is its channel.
+    TRACE_ID_EDGE_UP,        /// KeyCapture queued a key-up edge. The value is its channel.
+    TRACE_ID_EVENT           /// A KeyCaptureKeyer returned a MorseEvent. The value holds the
+                             /// keyer's channel in its high byte and the event in its low byte.
+} TraceId;
+
+/**
+ * Writes a trace record, unless tracing has been compiled out or isn't enabled.
+ * @param id The TraceId of the record.
+ * @param value The value of the record, which is truncated to 16 bits.
+ */
+#define TRACE(id, value) do {                       \
+    if (TRACE_ENABLE) {                             \
+        TraceWrite((id), (value));                  \
+    }                                               \
+} while (0)
+
+/**
+ * Turns the writing of trace records on or off. Tracing starts out off.
+ * @param enabled TRUE to write records from now on, FALSE to drop them.
+ */
+void TraceSetEnabled(int enabled);
+
+/**
+ * Returns TRUE while trace records are being written, FALSE otherwise.
+ */
+int TraceIsEnabled(void);
+
+/**
+ * Queues a trace record if tracing is enabled. Should only be called through TRACE().
+ */
+void TraceWrite(TraceId id, uint16_t value);
+
+#endif // TRACE_H
@@ -1,6 +1,14 @@
+#include <stdint.h>
+#include <stdlib.h>
 #include "Tree.h"
 #include "BOARD.h"
 
+// A pool counts its Nodes in 16 bits, so it must be able to count those of the deepest tree.
+typedef char TreeCheckMaxLevel[(TREE_NODE_COUNT(TREE_MAX_LEVEL) <= UINT16_MAX) ? 1 : -1];
+
+static Node *TreeBuild(int level, const char *data, TreePool *pool);
+static void TreeFreeNode(Node *node, void *context);
+
 /**
  * This function creates a binary tree of a given size given a serialized array of data. All nodes
  * are allocated on the heap via `malloc()` and store the input data in their data member. Note that
@@ -13,10 +21,12 @@
  *      D   E F   G
  * The data variable is ordered as [A B D E C F G].
  * 
- * This function uses recursion for generating the tree in this top-down, left-right order. This
- * tree, and therefore the input data set, is assumed to be full and balanced therefore each level
- * has 2^level number of nodes in it. If the `data` input is not this size, then this functions
- * behavior is undefined. Since the input data is copied directly into each node, they can
+ * This function generates the tree in this top-down, left-right order iteratively, keeping the
+ * right children still to be built in a work array of TREE_MAX_LEVEL entries instead of on the
+ * call stack, so building any tree takes the same small amount of stack and time linear in its
+ * size. This tree, and therefore the input data set, is assumed to be full and balanced therefore
+ * each level has 2^level number of nodes in it. If the `data` input is not this size, then this
+ * functions behavior is undefined. Since the input data is copied directly into each node, they can
  * originally be allocated on the stack.
  *
  * If allocating memory fails during TreeCreate() then it will return NULL. Additionally, if the
@@ -24,55 +34,167 @@
  * that if TreeCreate() returns a non-NULL value, that means that a perfect tree has been created,
  * so all nodes that should exist have been successfully malloc()'d onto the heap.
  *
- * This function does not completely clean up after itself if malloc() fails at any point. Some
- * nodes may be successfully free()d, but a failing TreeCreate() is likely to leave memory in the
- * heap unaccessible.
+ * If malloc() fails at any point, every node that was already allocated is free()d again before
+ * NULL is returned, so a failing TreeCreate() leaves the heap as it found it.
  *
  * @param level How many vertical levels the tree will have.
  * @param data A serialized array of the character data that will be stored in all nodes. This array
  *              should be of length `2^level - 1`.
- * @return The head of the created tree or NULL if malloc fails for any node.
+ * @return The head of the created tree or NULL if malloc fails for any node or `level` is not
+ *         from 1 to TREE_MAX_LEVEL.
  */
 
 Node *TreeCreate(int level, const char *data)
 {
-    //Notes: Level return: 1 less than number passed in
-
-    Node *tree = malloc(sizeof (tree));
-    if (tree == NULL) {
+    if (level < 1 || level > TREE_MAX_LEVEL) {
         return NULL;
-    } else {
-        tree->data = *data;
-        if (level == 0) {
-            tree->leftChild = NULL;
-            tree->rightChild = NULL;
-            return tree;
+    }
+    return TreeBuild(level, data, NULL);
+}
+
+int TreeTraverse(Node *root, TreeVisitor visit, void *context)
+{
+    // The right children that are still to be visited, deepest last. A node is followed by its
+    // left child, so at most one is waiting per level above the one being visited.
+    Node *pending[TREE_MAX_LEVEL];
+    int pendingCount = 0;
+    Node *node = root;
+
+    while (node != NULL) {
+        Node *left = node->leftChild;
+        if (node->rightChild != NULL) {
+            if (pendingCount == TREE_MAX_LEVEL) {
+                return STANDARD_ERROR;
+            }
+            pending[pendingCount++] = node->rightChild;
+        }
+        visit(node, context);
+
+        node = left;
+        if (node == NULL && pendingCount > 0) {
+            node = pending[--pendingCount];
         }
-        tree->leftChild = TreeCreate(level - 1, data + 1);
-        tree->rightChild = TreeCreate(level - 1, data + (1 << (level - 1)));
-        return tree;
     }
-    return NULL;
+    return SUCCESS;
+}
 
+void TreeFree(Node *root)
+{
+    TreeTraverse(root, TreeFreeNode, NULL);
+}
 
+int TreePoolInit(TreePool *pool, Node *nodes, int capacity)
+{
+    if (pool == NULL || nodes == NULL || capacity < 0 || capacity > UINT16_MAX) {
+        return STANDARD_ERROR;
+    }
+    pool->nodes = nodes;
+    pool->capacity = capacity;
+    pool->used = 0;
+    return SUCCESS;
+}
 
+Node *TreePoolAlloc(TreePool *pool)
+{
+    if (pool->used == pool->capacity) {
+        return NULL;
+    }
+    return &pool->nodes[pool->used++];
+}
 
+void TreePoolRelease(TreePool *pool)
+{
+    pool->used = 0;
+}
 
-    //    Node *node = malloc(sizeof (node));
-    //    if (node != NULL) {
-    //        node->data = data[0];
-    //        node->leftChild = TreeCreate(level - 1, data++);
-    //        node->rightChild = TreeCreate(level - 1, data + (2 << level));
-    //        if (node->leftChild == NULL || node->rightChild == NULL) {
-    //            return NULL;
-    //        }
-    //        if (level == 1) {
-    //            node->leftChild = NULL;
-    //            node->rightChild = NULL;
-    //            return node;
-    //        }
-    //    }
-    //    return node;
+Node *TreeCreateInPool(int level, const char *data, TreePool *pool)
+{
+    // Checking for room up front means building can't fail halfway, so there is never anything
+    // to hand back.
+    if (level < 1 || level > TREE_MAX_LEVEL ||
+            pool->capacity - pool->used < TREE_NODE_COUNT(level)) {
+        return NULL;
+    }
+    return TreeBuild(level, data, pool);
 }
 
+int TreeArrayCreate(int level, const char *data, char *tree)
+{
+    // The index and level of every right subtree still to be filled, like in TreeBuild().
+    uint32_t pendingIndex[TREE_MAX_LEVEL];
+    uint8_t pendingLevel[TREE_MAX_LEVEL];
+    int pendingCount = 0;
+    uint32_t index = TREE_ARRAY_ROOT;
+    int count;
+    int i;
 
+    if (level < 1 || level > TREE_MAX_LEVEL || data == NULL || tree == NULL) {
+        return STANDARD_ERROR;
+    }
+    tree[0] = '\0';
+    count = TREE_NODE_COUNT(level);
+    for (i = 0; i < count; ++i) {
+        tree[index] = data[i];
+        if (level > 1) {
+            pendingIndex[pendingCount] = TREE_ARRAY_RIGHT(index);
+            pendingLevel[pendingCount] = level - 1;
+            pendingCount++;
+            index = TREE_ARRAY_LEFT(index);
+            level--;
+        } else if (pendingCount > 0) {
+            pendingCount--;
+            index = pendingIndex[pendingCount];
+            level = pendingLevel[pendingCount];
+        }
+    }
+    return SUCCESS;
+}
+
+/**
+ * Builds a tree from `data` in the order it is serialized, taking Nodes from `pool` or from the
+ * heap if it is NULL. Each node is linked in as soon as it exists and starts out without
+ * children, so a tree that runs out of heap partway is still a valid tree and is freed whole. A
+ * pool is always checked for room first, so it never runs out.
+ */
+static Node *TreeBuild(int level, const char *data, TreePool *pool)
+{
+    // The links of the right subtrees still to be built, and how many levels each has. The left
+    // subtree of a node is always built right after it, so only the right ones have to wait.
+    Node **pendingLink[TREE_MAX_LEVEL];
+    uint8_t pendingLevel[TREE_MAX_LEVEL];
+    int pendingCount = 0;
+    Node *root = NULL;
+    Node **link = &root;
+    int count = TREE_NODE_COUNT(level);
+    int i;
+
+    for (i = 0; i < count; ++i) {
+        Node *node = (pool != NULL) ? TreePoolAlloc(pool) : malloc(sizeof (Node));
+        if (node == NULL) {
+            TreeFree(root);
+            return NULL;
+        }
+        node->data = data[i];
+        node->leftChild = NULL;
+        node->rightChild = NULL;
+        *link = node;
+
+        if (level > 1) {
+            pendingLink[pendingCount] = &node->rightChild;
+            pendingLevel[pendingCount] = level - 1;
+            pendingCount++;
+            link = &node->leftChild;
+            level--;
+        } else if (pendingCount > 0) {
+            pendingCount--;
+            link = pendingLink[pendingCount];
+            level = pendingLevel[pendingCount];
+        }
+    }
+    return root;
+}
+
+static void TreeFreeNode(Node *node, void *context)
+{
+    free(node);
+}
@@ -10,12 +10,23 @@
  * solution would work.
  * 
  * @note This libraries relies on malloc() being available and usage, therefore a heap must be set.
+ * Trees can instead be built from a TreePool of statically allocated Nodes, which needs no heap.
  *
  * Example usage for creating a tree:
  * char treeData[7] = "abdecfg"; // Not a string! Missing ending '\0'
  * Node *root = TreeCreate(3, treeData);
+ * TreeFree(root);
+ *
+ * Example usage for rebuilding a tree from a pool, without ever touching the heap:
+ * static Node nodes[TREE_NODE_COUNT(3)];
+ * static TreePool pool = TREE_POOL_INITIALIZER(nodes);
+ * Node *root = TreeCreateInPool(3, treeData, &pool);
+ * TreePoolRelease(&pool);
+ * root = TreeCreateInPool(3, otherData, &pool);
  */
 
+#include <stdint.h>
+
 /**
  * A node in the binary tree. This is the only element used for representing the tree and there's no
  * object used to represent the tree as a whole. It has a left child, right child, and single char.
@@ -29,6 +40,17 @@ typedef struct Node {
 	char data;
 } Node;
 
+// The deepest tree that can be created or traversed. The work arrays that replace recursion in
+// this library are sized by it, so their stack use doesn't depend on the tree.
+#define TREE_MAX_LEVEL 16
+
+/**
+ * A function called on each Node of a tree by TreeTraverse().
+ * @param node The Node being visited. Its children have already been read, so it may be freed.
+ * @param context The pointer passed to TreeTraverse().
+ */
+typedef void (*TreeVisitor)(Node *node, void *context);
+
 /**
  * This function creates a binary tree of a given size given a serialized array of data. All nodes
  * are allocated on the heap via `malloc()` and store the input data in their data member. Note that
@@ -41,10 +63,12 @@ typedef struct Node {
  *      D   E F   G
  * The data variable is ordered as [A B D E C F G].
  * 
- * This function uses recursion for generating the tree in this top-down, left-right order. This
- * tree, and therefore the input data set, is assumed to be full and balanced therefore each level
- * has 2^level number of nodes in it. If the `data` input is not this size, then this functions
- * behavior is undefined. Since the input data is copied directly into each node, they can
+ * This function generates the tree in this top-down, left-right order iteratively, keeping the
+ * right children still to be built in a work array of TREE_MAX_LEVEL entries instead of on the
+ * call stack, so building any tree takes the same small amount of stack and time linear in its
+ * size. This tree, and therefore the input data set, is assumed to be full and balanced therefore
+ * each level has 2^level number of nodes in it. If the `data` input is not this size, then this
+ * functions behavior is undefined. Since the input data is copied directly into each node, they can
  * originally be allocated on the stack.
  *
  * If allocating memory fails during TreeCreate() then it will return NULL. Additionally, if the
@@ -52,15 +76,124 @@ typedef struct Node {
  * that if TreeCreate() returns a non-NULL value, that means that a perfect tree has been created,
  * so all nodes that should exist have been successfully malloc()'d onto the heap.
  *
- * This function does not completely clean up after itself if malloc() fails at any point. Some
- * nodes may be successfully free()d, but a failing TreeCreate() is likely to leave memory in the
- * heap unaccessible.
+ * If malloc() fails at any point, every node that was already allocated is free()d again before
+ * NULL is returned, so a failing TreeCreate() leaves the heap as it found it.
  *
  * @param level How many vertical levels the tree will have.
  * @param data A serialized array of the character data that will be stored in all nodes. This array
  *              should be of length `2^level - 1`.
- * @return The head of the created tree or NULL if malloc fails for any node.
+ * @return The head of the created tree or NULL if malloc fails for any node or `level` is not
+ *         from 1 to TREE_MAX_LEVEL.
  */
 Node *TreeCreate(int level, const char *data);
 
+/**
+ * Visits every node of a tree in the same top-down, left-right order that TreeCreate() takes its
+ * data in, iteratively with a work array of TREE_MAX_LEVEL entries.
+ * @param root The head of the tree, which may be NULL.
+ * @param visit The function called on each node.
+ * @param context Passed on to `visit`.
+ * @return SUCCESS or STANDARD_ERROR if the tree has more than TREE_MAX_LEVEL levels, in which case
+ *         the traversal stops where the work array fills up and the rest of the nodes are never
+ *         visited.
+ */
+int TreeTraverse(Node *root, TreeVisitor visit, void *context);
+
+/**
+ * Frees every node of a tree created by TreeCreate(). Must not be used on a tree from a TreePool,
+ * which are released with TreePoolRelease() instead.
+ * @param root The head of the tree, which may be NULL.
+ */
+void TreeFree(Node *root);
+
+// The number of Nodes in a perfect tree with `level` vertical levels.
+#define TREE_NODE_COUNT(level) ((1 << (level)) - 1)
+
+/**
+ * A fixed block of Nodes that trees are built from instead of the heap. Nodes are handed out in
+ * order, so allocating one is a single increment, and all of them are released at once. Its
+ * members should be treated as private.
+ */
+typedef struct {
+    Node *nodes;
+    uint16_t capacity;
+    uint16_t used;
+} TreePool;
+
+/**
+ * Statically initializes an empty TreePool using `nodes`, which must be an array (not a pointer)
+ * of Nodes. TREE_NODE_COUNT() gives the size needed for a tree.
+ */
+#define TREE_POOL_INITIALIZER(nodes) { (nodes), sizeof (nodes) / sizeof (Node), 0 }
+
+/**
+ * Initializes an empty TreePool at runtime.
+ * @param pool The pool to initialize.
+ * @param nodes Storage for the pool's Nodes, which must stay valid as long as the pool is used.
+ * @param capacity The number of Nodes in `nodes`.
+ * @return SUCCESS or STANDARD_ERROR if `capacity` is out of range or any pointer is NULL.
+ */
+int TreePoolInit(TreePool *pool, Node *nodes, int capacity);
+
+/**
+ * Takes the next free Node from a pool.
+ * @param pool The pool to allocate from.
+ * @return The Node, with its members left as they were, or NULL if the pool is used up.
+ */
+Node *TreePoolAlloc(TreePool *pool);
+
+/**
+ * Returns every Node of a pool at once, which invalidates every tree that was built from it.
+ * @param pool The pool to release.
+ */
+void TreePoolRelease(TreePool *pool);
+
+/**
+ * Creates a tree exactly like TreeCreate(), except that its Nodes are taken from a pool. The pool
+ * is checked for TREE_NODE_COUNT(level) free Nodes before any are taken, so if it doesn't have
+ * enough, NULL is returned without touching it and the trees it already holds are left as they
+ * were.
+ * @param level How many vertical levels the tree will have.
+ * @param data A serialized array of the character data that will be stored in all nodes. This array
+ *              should be of length `2^level - 1`.
+ * @param pool The pool the Nodes come from.
+ * @return The head of the created tree or NULL if the pool doesn't have TREE_NODE_COUNT(level)
+ *         free Nodes or `level` is not from 1 to TREE_MAX_LEVEL.
+ */
+Node *TreeCreateInPool(int level, const char *data, TreePool *pool);
+
+/**
+ * The flat tree backend stores a perfect tree in a single array instead of in individually
+ * allocated Nodes. Nodes are laid out in level-order starting at index 1, so the root is at index
+ * TREE_ARRAY_ROOT and the children of the node at index `i` are found at TREE_ARRAY_LEFT(i) and
+ * TREE_ARRAY_RIGHT(i). Index 0 is unused, which keeps the child computations to a shift and an OR.
+ *
+ * For the same tree as above:
+ *           A
+ *        B     C
+ *      D   E F   G
+ * The array is ordered as [- A B C D E F G].
+ */
+#define TREE_ARRAY_ROOT 1
+#define TREE_ARRAY_LEFT(i) ((i) << 1)
+#define TREE_ARRAY_RIGHT(i) (((i) << 1) | 1)
+
+// The number of chars required to store a flat tree with `level` vertical levels.
+#define TREE_ARRAY_SIZE(level) (1 << (level))
+
+/**
+ * This function fills a flat, heap-free binary tree from the same serialized data that
+ * TreeCreate() uses. `tree` must be at least TREE_ARRAY_SIZE(level) chars long and will have the
+ * nodes stored at the indices described above, with `tree[0]` set to '\0'. No memory is allocated,
+ * so `tree` can be a static array that is filled once at startup.
+ *
+ * @param level How many vertical levels the tree will have.
+ * @param data A serialized array of the character data that will be stored in all nodes. This array
+ *              should be of length `2^level - 1`.
+ * @param tree The array receiving the flat tree.
+ * @return SUCCESS if the tree was filled or STANDARD_ERROR if `level` is not from 1 to
+ *         TREE_MAX_LEVEL or any pointer is NULL.
+ */
+int TreeArrayCreate(int level, const char *data, char *tree);
+
 #endif // TREE_H
@@ -0,0 +1,120 @@
+#include <stdint.h>
+#include "Uart.h"
+#include "Ring.h"
+#include "BOARD.h"
+
+// Microchip libraries
+#include <xc.h>
+#include <plib.h>
+
+static uint8_t rxBuffer[UART_RX_BUFFER_SIZE];
+static Ring rxRing = RING_INITIALIZER(rxBuffer);
+
+// Bytes can be queued for sending from any priority, so they are put with interrupts disabled and
+// the TX interrupt is the only consumer.
+static uint8_t txBuffer[UART_TX_BUFFER_SIZE];
+static Ring txRing = RING_INITIALIZER(txBuffer);
+
+// Bytes lost to the UART's FIFO overrunning, which clears it.
+static volatile uint32_t fifoOverruns;
+
+void UartInit(void)
+{
+    INTEnable(INT_U1RX, INT_DISABLED);
+    while (U1STAbits.URXDA) {
+        (void) U1RXREG;
+    }
+    U1STAbits.OERR = 0;
+    fifoOverruns = 0;
+
+    // The FIFO holds 4 bytes, or about 350us at 115200 baud, which is plenty of time even at the
+    // low priority of the OLED transfers.
+    INTClearFlag(INT_U1RX);
+    INTSetVectorPriority(INT_UART_1_VECTOR, INT_PRIORITY_LEVEL_3);
+    INTSetVectorSubPriority(INT_UART_1_VECTOR, INT_SUB_PRIORITY_LEVEL_1);
+    INTEnable(INT_U1RX, INT_ENABLED);
+    INTClearFlag(INT_U1TX);
+    if (RingCount(&txRing) > 0) {
+        INTEnable(INT_U1TX, INT_ENABLED);
+    }
+}
+
+int UartGetChar(uint8_t *data)
+{
+    return RingGet(&rxRing, data);
+}
+
+int UartRead(uint8_t *buffer, int size)
+{
+    int count = 0;
+    while (count < size && RingGet(&rxRing, &buffer[count]) == SUCCESS) {
+        count++;
+    }
+    return count;
+}
+
+uint32_t UartGetRxOverflows(void)
+{
+    return rxRing.overflows + fifoOverruns;
+}
+
+int UartPutChar(uint8_t data)
+{
+    return UartWrite(&data, 1);
+}
+
+int UartWrite(const uint8_t *data, int size)
+{
+    unsigned int status = INTDisableInterrupts();
+    int i;
+    if (UART_TX_BUFFER_SIZE - RingCount(&txRing) < (uint32_t) size) {
+        txRing.overflows += size;
+        INTRestoreInterrupts(status);
+        return STANDARD_ERROR;
+    }
+    for (i = 0; i < size; ++i) {
+        RingPut(&txRing, data[i]);
+    }
+    INTEnable(INT_U1TX, INT_ENABLED);
+    INTRestoreInterrupts(status);
+    return SUCCESS;
+}
+
+int UartGetTxSpace(void)
+{
+    return UART_TX_BUFFER_SIZE - RingCount(&txRing);
+}
+
+uint32_t UartGetTxOverflows(void)
+{
+    return txRing.overflows;
+}
+
+void __ISR(_UART_1_VECTOR, IPL3AUTO) UartInterrupt(void)
+{
+    uint8_t data;
+
+    // The interrupt is disabled before the ring is found empty, so any byte queued in between
+    // enables it again instead of being stranded.
+    if (INTGetFlag(INT_U1TX) && INTGetEnable(INT_U1TX)) {
+        INTEnable(INT_U1TX, INT_DISABLED);
+        while (!U1STAbits.UTXBF && RingGet(&txRing, &data) == SUCCESS) {
+            U1TXREG = data;
+        }
+        INTClearFlag(INT_U1TX);
+        if (RingCount(&txRing) > 0) {
+            INTEnable(INT_U1TX, INT_ENABLED);
+        }
+    }
+
+    while (U1STAbits.URXDA) {
+        RingPut(&rxRing, U1RXREG);
+    }
+
+    // An overrun stops the UART receiving until it's cleared, which also empties the FIFO.
+    if (U1STAbits.OERR) {
+        U1STAbits.OERR = 0;
+        fifoOverruns++;
+    }
+    INTClearFlag(INT_U1RX);
+}
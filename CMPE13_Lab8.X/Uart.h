@@ -0,0 +1,95 @@
+#ifndef UART_H
+#define UART_H
+
+/**
+ * @file
+ *
+ * This library receives from and sends to UART1 through its interrupts instead of by polling. Every
+ * byte is moved from the UART's 4-byte FIFO into a UART_RX_BUFFER_SIZE byte Ring as soon as it
+ * arrives, so the main loop can read whole blocks of input at once without ever busy-waiting or
+ * losing bytes to the FIFO overrunning while it is busy with something else.
+ *
+ * Sending works the other way around: UartPutChar() and UartWrite() only copy into a
+ * UART_TX_BUFFER_SIZE byte Ring, which the TX interrupt then feeds into the FIFO. Queuing a byte
+ * takes microseconds instead of the 87us it takes to send at 115200 baud, so it is safe to do from
+ * an interrupt. Bytes that don't fit are dropped rather than waited for. Anything printed with
+ * printf() still goes straight to the UART, and may be interleaved with queued output.
+ *
+ * UART1 must already have been set up by BOARD_Init(). Once UartInit() has been called all input
+ * goes to this library, so the read() override in BOARD.c used by scanf() will no longer see any.
+ *
+ * Example usage for handling input in blocks:
+ * uint8_t block[16];
+ * int count;
+ * UartInit();
+ * while (1) {
+ *     count = UartRead(block, sizeof (block));
+ *     // Handle `count` bytes from `block`.
+ * }
+ */
+
+#include <stdint.h>
+
+// How many received bytes can be waiting to be read before new ones are dropped. Must be a power
+// of two.
+#define UART_RX_BUFFER_SIZE 256
+
+// How many bytes can be waiting to be sent before new ones are dropped. Must be a power of two.
+#define UART_TX_BUFFER_SIZE 256
+
+/**
+ * Starts receiving from UART1 through its interrupt, dropping anything already in its FIFO. Bytes
+ * can be queued for sending before this is called, but are only sent once it has been.
+ */
+void UartInit(void);
+
+/**
+ * Removes the oldest received byte.
+ * @param data Where the byte is stored.
+ * @return SUCCESS or STANDARD_ERROR if nothing has been received.
+ */
+int UartGetChar(uint8_t *data);
+
+/**
+ * Removes as many received bytes as are available, up to `size`.
+ * @param buffer Where the bytes are stored.
+ * @param size How many bytes fit in `buffer`.
+ * @return How many bytes were stored, which is 0 if nothing has been received.
+ */
+int UartRead(uint8_t *buffer, int size);
+
+/**
+ * Returns how many received bytes have been lost, either because the receive buffer was full or
+ * because the UART's own FIFO overran.
+ */
+uint32_t UartGetRxOverflows(void);
+
+/**
+ * Queues a byte to be sent. This can be called from the main loop and from any interrupt.
+ * @param data The byte to send.
+ * @return SUCCESS or STANDARD_ERROR if the send buffer was full and the byte was dropped.
+ */
+int UartPutChar(uint8_t data);
+
+/**
+ * Queues a block of bytes to be sent, all together so that they aren't interleaved with bytes
+ * queued from an interrupt. This can be called from the main loop and from any interrupt.
+ * @param data The bytes to send.
+ * @param size How many bytes to send.
+ * @return SUCCESS or STANDARD_ERROR if the send buffer didn't have room for all of them, in which
+ *         case none are queued and all are counted as dropped.
+ */
+int UartWrite(const uint8_t *data, int size);
+
+/**
+ * Returns how many bytes can be queued right now without any being dropped. Only ever grows until
+ * something else queues bytes, so a block of this size or less can then be written whole.
+ */
+int UartGetTxSpace(void);
+
+/**
+ * Returns how many bytes have been dropped because the send buffer was full.
+ */
+uint32_t UartGetTxOverflows(void);
+
+#endif // UART_H
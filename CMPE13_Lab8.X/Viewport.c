@@ -0,0 +1,145 @@
+#include <stdint.h>
+#include "Viewport.h"
+#include "OledText.h"
+#include "BOARD.h"
+
+typedef char ViewportCheckHistory[(VIEWPORT_HISTORY_LINES >= OLED_NUM_LINES) ? 1 : -1];
+
+// The remembered lines, stored as a ring with `newest` being the line currently being added to.
+static char history[VIEWPORT_HISTORY_LINES][OLED_CHARS_PER_LINE];
+static uint8_t lengths[VIEWPORT_HISTORY_LINES];
+static uint8_t newest;
+
+// Where the window is on the screen, which of its lines shows the newest history line and whether
+// it is being drawn at all.
+static uint8_t windowFirst;
+static uint8_t windowCount;
+static uint8_t cursorLine;
+static uint8_t hidden;
+
+static void ViewportNewLine(void);
+static void ViewportRedraw(void);
+
+int ViewportInit(int firstLine, int lineCount)
+{
+    if (firstLine < 0 || lineCount < 1 || firstLine + lineCount > OLED_NUM_LINES) {
+        return STANDARD_ERROR;
+    }
+    windowFirst = firstLine;
+    windowCount = lineCount;
+    hidden = FALSE;
+    ViewportClear();
+    return SUCCESS;
+}
+
+void ViewportPutChar(char c)
+{
+    if (windowCount == 0) {
+        return;
+    }
+    if (c == '\n') {
+        ViewportNewLine();
+        return;
+    }
+    if (lengths[newest] == OLED_CHARS_PER_LINE) {
+        ViewportNewLine();
+    }
+    history[newest][lengths[newest]] = c;
+    if (!hidden) {
+        OledTextPutChar(windowFirst + cursorLine, lengths[newest], c);
+    }
+    lengths[newest]++;
+}
+
+void ViewportClear(void)
+{
+    int i;
+    for (i = 0; i < VIEWPORT_HISTORY_LINES; ++i) {
+        lengths[i] = 0;
+    }
+    newest = 0;
+    cursorLine = 0;
+    for (i = 0; i < windowCount && !hidden; ++i) {
+        OledTextClearLine(windowFirst + i);
+    }
+}
+
+void ViewportSetVisible(int visible)
+{
+    if (visible && hidden) {
+        ViewportRedraw();
+    }
+    hidden = !visible;
+}
+
+int ViewportResize(int lineCount)
+{
+    int i;
+    if (lineCount < 1 || windowFirst + lineCount > OLED_NUM_LINES) {
+        return STANDARD_ERROR;
+    }
+    for (i = lineCount; i < windowCount && !hidden; ++i) {
+        OledTextClearLine(windowFirst + i);
+    }
+    windowCount = lineCount;
+    if (cursorLine >= windowCount) {
+        cursorLine = windowCount - 1;
+    }
+    if (!hidden) {
+        ViewportRedraw();
+    }
+    return SUCCESS;
+}
+
+int ViewportGetLine(int age, char *string)
+{
+    int line;
+    int i;
+    if (age < 0 || age >= VIEWPORT_HISTORY_LINES) {
+        return SIZE_ERROR;
+    }
+    line = newest - age;
+    if (line < 0) {
+        line += VIEWPORT_HISTORY_LINES;
+    }
+    for (i = 0; i < lengths[line]; ++i) {
+        string[i] = history[line][i];
+    }
+    string[i] = '\0';
+    return i;
+}
+
+/**
+ * Moves on to a fresh line, scrolling the window if its last line was already in use. Scrolling
+ * reuses what is already in the frame buffer, so only the new, empty line needs drawing.
+ */
+static void ViewportNewLine(void)
+{
+    if (++newest == VIEWPORT_HISTORY_LINES) {
+        newest = 0;
+    }
+    lengths[newest] = 0;
+
+    if (cursorLine + 1 < windowCount) {
+        cursorLine++;
+    } else if (!hidden) {
+        OledTextScrollUp(windowFirst, windowCount);
+    }
+}
+
+/**
+ * Draws the whole window from the history. The cursor line shows the newest history line and
+ * every line above it the one before.
+ */
+static void ViewportRedraw(void)
+{
+    char string[OLED_CHARS_PER_LINE + 1];
+    int i;
+    for (i = 0; i < windowCount; ++i) {
+        OledTextClearLine(windowFirst + i);
+        if (i <= cursorLine) {
+            ViewportGetLine(cursorLine - i, string);
+            OledTextPutString(windowFirst + i, 0, string);
+        }
+    }
+}
@@ -0,0 +1,82 @@
+#ifndef VIEWPORT_H
+#define VIEWPORT_H
+
+/**
+ * @file
+ *
+ * This library implements a scrolling window of text on the OLED for showing decoded Morse code.
+ * Characters are added one at a time to the end of the newest line and wrap onto a new line once
+ * OLED_CHARS_PER_LINE have been added. When the window is full, starting a new line scrolls every
+ * line in the window up by one using OledTextScrollUp(), which shifts the frame buffer a page at a
+ * time instead of redrawing each line. So every character costs the same to render no matter how
+ * long a transmission gets.
+ *
+ * The window can cover any consecutive block of lines, leaving the rest of the screen free for
+ * other uses through OledText.h. The last VIEWPORT_HISTORY_LINES lines of text are also kept,
+ * including those that already scrolled out of the window, and can be read with ViewportGetLine().
+ *
+ * Drawing is done through OledText.h, so OledTextUpdate() must be called to show any changes.
+ *
+ * Example usage for a 3-line window at the top of the screen:
+ * OledInit();
+ * OledTextInit();
+ * ViewportInit(0, 3);
+ * ViewportPutChar('S');
+ * ViewportPutChar('O');
+ * ViewportPutChar('S');
+ * OledTextUpdate();
+ */
+
+#include "Oled.h"
+
+// How many lines of text are remembered, including the ones in the window. Must be at least as
+// many as OLED_NUM_LINES.
+#define VIEWPORT_HISTORY_LINES 16
+
+/**
+ * Sets up the window and clears it along with all history. OledTextInit() must have been called.
+ * @param firstLine The top line of the screen covered by the window.
+ * @param lineCount How many lines the window covers.
+ * @return SUCCESS or STANDARD_ERROR if the window doesn't fit on the screen.
+ */
+int ViewportInit(int firstLine, int lineCount);
+
+/**
+ * Adds a character to the end of the newest line, first starting a new line if it is full. A '\n'
+ * starts a new line without adding anything.
+ * @param c The character to add.
+ */
+void ViewportPutChar(char c);
+
+/**
+ * Clears the window and forgets all history.
+ */
+void ViewportClear(void);
+
+/**
+ * Stops or resumes drawing the window, so that the lines it covers can show something else for a
+ * while. Characters added while it is hidden are still kept in the history, and showing it again
+ * redraws the window from the newest lines.
+ * @param visible FALSE to stop drawing, TRUE to redraw the window and draw into it again.
+ */
+void ViewportSetVisible(int visible);
+
+/**
+ * Changes how many lines the window covers, keeping its top line and all history. The window is
+ * redrawn from the newest lines, and lines it no longer covers are cleared for other uses.
+ * @param lineCount How many lines the window covers from now on.
+ * @return SUCCESS or STANDARD_ERROR if the window wouldn't fit on the screen, in which case it
+ *         isn't changed.
+ */
+int ViewportResize(int lineCount);
+
+/**
+ * Copies a line of the history out as a null-terminated string.
+ * @param age Which line to copy, where 0 is the newest line and VIEWPORT_HISTORY_LINES - 1 is the
+ *            oldest one remembered.
+ * @param string Where to store the string. Must hold at least OLED_CHARS_PER_LINE + 1 chars.
+ * @return The number of characters copied, or SIZE_ERROR if `age` is out of range.
+ */
+int ViewportGetLine(int age, char *string);
+
+#endif // VIEWPORT_H
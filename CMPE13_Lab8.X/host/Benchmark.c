@@ -0,0 +1,468 @@
+/**
+ * @file
+ *
+ * Microbenchmarks for the portable decoding and rendering modules, built for the host by the
+ * Makefile in this directory. Each benchmark repeats its operation enough times to take a
+ * measurable amount of time and reports the average cost of one operation in nanoseconds, so runs
+ * can be compared against each other to see what a change did. The numbers are for the host CPU,
+ * not the PIC32; only their relative changes mean anything.
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "BOARD.h"
+#include "Buttons.h"
+#include "EventLog.h"
+#include "KeyCapture.h"
+#include "Morse.h"
+#include "MorseTable.h"
+#include "OledText.h"
+#include "Tree.h"
+#include "Viewport.h"
+#include "HostStubs.h"
+
+// The text every decoding benchmark works on, repeated to make a longer stream.
+#define BENCHMARK_TEXT "THE QUICK BROWN FOX JUMPS OVER THE LAZY DOG 0123456789 CQ DE KJ6ABC 73"
+#define BENCHMARK_TEXT_REPEATS 64
+#define BENCHMARK_TEXT_LENGTH (sizeof (BENCHMARK_TEXT) * BENCHMARK_TEXT_REPEATS)
+
+// The simulated keying, in 100Hz ticks: DOTs and DASHes are well inside the fixed
+// MorseEventLengths, as are the gaps between elements, letters and words.
+#define BENCHMARK_DOT_TICKS 10
+#define BENCHMARK_DASH_TICKS 70
+#define BENCHMARK_ELEMENT_GAP_TICKS 10
+#define BENCHMARK_LETTER_GAP_TICKS 120
+#define BENCHMARK_WORD_GAP_TICKS 250
+
+// The levels of the tree built by the tree benchmarks, the same as the Morse tree.
+#define BENCHMARK_TREE_LEVELS 8
+
+// The Morse code of BENCHMARK_TEXT as DOTs and DASHes, with a ' ' after every letter and another
+// after every word.
+static char morse[BENCHMARK_TEXT_LENGTH * (MORSE_SYMBOL_MAX_LENGTH + 2) + 1];
+
+// The simulated button events of keying `morse` on BTN4, one per tick.
+static uint8_t *keying;
+static int keyingLength;
+
+// The EventLog of the edges of `keying`, which is at most the header and a byte per tick.
+static uint8_t *eventLog;
+static int eventLogLength;
+
+static uint64_t BenchmarkNow(void);
+static void BenchmarkReport(const char *name, uint64_t elapsed, long operations);
+static void BenchmarkEncodeText(void);
+static int BenchmarkKeyMorse(uint8_t *events);
+static void BenchmarkBuildKeying(void);
+static uint32_t BenchmarkTreeCreate(void);
+static uint32_t BenchmarkTreeCreateInPool(void);
+static uint32_t BenchmarkTreeArrayCreate(void);
+static uint32_t BenchmarkDecodeElements(void);
+static uint32_t BenchmarkDecodeString(void);
+static uint32_t BenchmarkKeying(void);
+static int BenchmarkCountLetters(void);
+static uint32_t BenchmarkReplay(void);
+static int BenchmarkLogSink(const uint8_t *data, int size);
+static uint32_t BenchmarkRenderCell(void);
+static uint32_t BenchmarkRenderScreen(void);
+static uint32_t BenchmarkRenderViewport(void);
+
+int main(void)
+{
+    uint32_t check = 0;
+
+    BenchmarkEncodeText();
+    BenchmarkBuildKeying();
+    MorseInit();
+    OledTextInit();
+
+    check += BenchmarkTreeCreate();
+    check += BenchmarkTreeCreateInPool();
+    check += BenchmarkTreeArrayCreate();
+    check += BenchmarkDecodeElements();
+    check += BenchmarkDecodeString();
+    check += BenchmarkKeying();
+    check += BenchmarkReplay();
+    check += BenchmarkRenderCell();
+    check += BenchmarkRenderScreen();
+    check += BenchmarkRenderViewport();
+
+    // Printing something that depends on every result keeps the compiler from dropping any of it.
+    printf("check %08x\n", (unsigned int) check);
+    return 0;
+}
+
+/**
+ * Returns a monotonic time in nanoseconds.
+ */
+static uint64_t BenchmarkNow(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t) now.tv_sec * 1000000000 + now.tv_nsec;
+}
+
+static void BenchmarkReport(const char *name, uint64_t elapsed, long operations)
+{
+    printf("%-36s %10.2f ns/op %10ld ops\n", name, (double) elapsed / operations, operations);
+}
+
+/**
+ * Fills `morse` with the Morse code for BENCHMARK_TEXT_REPEATS copies of BENCHMARK_TEXT.
+ */
+#define BENCHMARK_CASE(c, length, elements) case c: codeLength = length; code = elements; break;
+static void BenchmarkEncodeText(void)
+{
+    const char *text = BENCHMARK_TEXT " ";
+    int out = 0;
+    int repeat;
+    int i;
+
+    for (repeat = 0; repeat < BENCHMARK_TEXT_REPEATS; ++repeat) {
+        for (i = 0; text[i] != '\0'; ++i) {
+            int codeLength = 0;
+            int code = 0;
+            int bit;
+
+            switch (text[i]) {
+                MORSE_CODE_TABLE(BENCHMARK_CASE)
+            }
+            if (text[i] == ' ') {
+                morse[out++] = ' ';
+                continue;
+            }
+            for (bit = codeLength - 1; bit >= 0; --bit) {
+                morse[out++] = (code & (1 << bit)) ? MORSE_CHAR_DASH : MORSE_CHAR_DOT;
+            }
+            morse[out++] = ' ';
+        }
+    }
+    morse[out] = '\0';
+}
+
+/**
+ * Walks `morse` as if keying it on BTN4 at the BENCHMARK_* timings, and returns how many ticks
+ * that takes. The button events of every tick are stored in `events` unless it's NULL.
+ */
+static int BenchmarkKeyMorse(uint8_t *events)
+{
+    int tick = 0;
+    int i;
+
+    for (i = 0; morse[i] != '\0'; ++i) {
+        if (morse[i] == MORSE_CHAR_DOT || morse[i] == MORSE_CHAR_DASH) {
+            if (events != NULL) {
+                events[tick] = BUTTON_EVENT_4DOWN;
+            }
+            tick += (morse[i] == MORSE_CHAR_DOT) ? BENCHMARK_DOT_TICKS : BENCHMARK_DASH_TICKS;
+            if (events != NULL) {
+                events[tick] = BUTTON_EVENT_4UP;
+            }
+            tick += BENCHMARK_ELEMENT_GAP_TICKS;
+        } else if (i > 0 && morse[i - 1] == ' ') {
+            // The second ' ' of a word gap only lengthens the gap a letter gap started.
+            tick += BENCHMARK_WORD_GAP_TICKS - BENCHMARK_LETTER_GAP_TICKS;
+        } else {
+            tick += BENCHMARK_LETTER_GAP_TICKS;
+        }
+    }
+    return tick;
+}
+
+/**
+ * Fills `keying` with the button events of keying `morse`.
+ */
+static void BenchmarkBuildKeying(void)
+{
+    // Walk once to count the ticks, so that the events can be stored in one allocation.
+    keyingLength = BenchmarkKeyMorse(NULL);
+    keying = calloc(keyingLength, 1);
+    if (keying == NULL) {
+        exit(1);
+    }
+    BenchmarkKeyMorse(keying);
+}
+
+static uint32_t BenchmarkTreeCreate(void)
+{
+    const long iterations = 20000;
+    char data[TREE_ARRAY_SIZE(BENCHMARK_TREE_LEVELS)];
+    uint32_t check = 0;
+    uint64_t start;
+    long i;
+
+    memset(data, 'x', sizeof (data));
+    start = BenchmarkNow();
+    for (i = 0; i < iterations; ++i) {
+        Node *root = TreeCreate(BENCHMARK_TREE_LEVELS, data);
+        check += root->data;
+        TreeFree(root);
+    }
+    BenchmarkReport("TreeCreate (8 levels, incl. free)", BenchmarkNow() - start, iterations);
+    return check;
+}
+
+static uint32_t BenchmarkTreeCreateInPool(void)
+{
+    const long iterations = 200000;
+    static Node nodes[TREE_NODE_COUNT(BENCHMARK_TREE_LEVELS)];
+    TreePool pool = TREE_POOL_INITIALIZER(nodes);
+    char data[TREE_ARRAY_SIZE(BENCHMARK_TREE_LEVELS)];
+    uint32_t check = 0;
+    uint64_t start;
+    long i;
+
+    memset(data, 'x', sizeof (data));
+    start = BenchmarkNow();
+    for (i = 0; i < iterations; ++i) {
+        Node *root = TreeCreateInPool(BENCHMARK_TREE_LEVELS, data, &pool);
+        check += root->data;
+        TreePoolRelease(&pool);
+    }
+    BenchmarkReport("TreeCreateInPool (8 levels)", BenchmarkNow() - start, iterations);
+    return check;
+}
+
+static uint32_t BenchmarkTreeArrayCreate(void)
+{
+    const long iterations = 200000;
+    char data[TREE_ARRAY_SIZE(BENCHMARK_TREE_LEVELS)];
+    char tree[TREE_ARRAY_SIZE(BENCHMARK_TREE_LEVELS)];
+    uint32_t check = 0;
+    uint64_t start;
+    long i;
+
+    memset(data, 'x', sizeof (data));
+    start = BenchmarkNow();
+    for (i = 0; i < iterations; ++i) {
+        data[0] = i;
+        TreeArrayCreate(BENCHMARK_TREE_LEVELS, data, tree);
+        check += tree[TREE_ARRAY_ROOT];
+    }
+    BenchmarkReport("TreeArrayCreate (8 levels)", BenchmarkNow() - start, iterations);
+    return check;
+}
+
+static uint32_t BenchmarkDecodeElements(void)
+{
+    const int repeats = 100;
+    MorseDecoder decoder;
+    uint32_t check = 0;
+    long operations = 0;
+    uint64_t start;
+    int repeat;
+    int i;
+
+    MorseDecoderInit(&decoder, MORSE_CHANNEL_BTN4);
+    start = BenchmarkNow();
+    for (repeat = 0; repeat < repeats; ++repeat) {
+        for (i = 0; morse[i] != '\0'; ++i) {
+            MorseChar in = (morse[i] == ' ') ? MORSE_CHAR_END_OF_CHAR : (MorseChar) morse[i];
+            check += MorseDecoderDecode(&decoder, in);
+        }
+        operations += i;
+    }
+    BenchmarkReport("MorseDecoderDecode (per element)", BenchmarkNow() - start, operations);
+    return check;
+}
+
+static uint32_t BenchmarkDecodeString(void)
+{
+    const int repeats = 100;
+    static char text[BENCHMARK_TEXT_LENGTH + 1];
+    uint32_t check = 0;
+    size_t length = strlen(morse);
+    uint64_t start;
+    int repeat;
+
+    start = BenchmarkNow();
+    for (repeat = 0; repeat < repeats; ++repeat) {
+        check += MorseDecodeString(morse, text, sizeof (text), NULL);
+        check += text[repeat];
+    }
+    BenchmarkReport("MorseDecodeString (per input char)", BenchmarkNow() - start, repeats * length);
+    return check;
+}
+
+static uint32_t BenchmarkKeying(void)
+{
+    const int repeats = 20;
+    uint32_t check = 0;
+    long decoded = 0;
+    uint64_t start;
+    int repeat;
+    int tick;
+
+    start = BenchmarkNow();
+    for (repeat = 0; repeat < repeats; ++repeat) {
+        MorseInit();
+        for (tick = 0; tick < keyingLength; ++tick) {
+            MorseEvent event;
+            HostButtonsSetEvents(keying[tick]);
+            event = MorseCheckEvents();
+            if (event == MORSE_EVENT_DOT) {
+                MorseDecode(MORSE_CHAR_DOT);
+            } else if (event == MORSE_EVENT_DASH) {
+                MorseDecode(MORSE_CHAR_DASH);
+            } else if (event == MORSE_EVENT_INTER_LETTER) {
+                char letter = MorseDecode(MORSE_CHAR_END_OF_CHAR);
+                if (letter != STANDARD_ERROR) {
+                    check += letter;
+                    decoded++;
+                }
+            }
+        }
+    }
+    BenchmarkReport("Keying stream (per 100Hz tick)", BenchmarkNow() - start,
+            (long) repeats * keyingLength);
+    printf("%-36s %10ld of %ld letters\n", "Keying stream decoded", decoded / repeats,
+            (long) BenchmarkCountLetters());
+    return check;
+}
+
+/**
+ * Returns how many letters `morse` holds, which is how many should be decoded from it.
+ */
+static int BenchmarkCountLetters(void)
+{
+    int letters = 0;
+    int i;
+
+    for (i = 0; morse[i] != '\0'; ++i) {
+        if (morse[i] == ' ' && i > 0 && morse[i - 1] != ' ') {
+            letters++;
+        }
+    }
+    return letters;
+}
+
+static int BenchmarkLogSink(const uint8_t *data, int size)
+{
+    memcpy(&eventLog[eventLogLength], data, size);
+    eventLogLength += size;
+    return SUCCESS;
+}
+
+static uint32_t BenchmarkReplay(void)
+{
+    const int repeats = 20;
+    const uint32_t tickCounts = BOARD_GetSysClock() / 2 / MORSE_TICKS_PER_SECOND;
+    EventLogRecorder recorder;
+    uint32_t check = 0;
+    long ticks = 0;
+    uint64_t start;
+    int repeat;
+    int tick;
+
+    // Records here take at most 6 bytes and are at least 10 ticks apart, so a byte per tick is
+    // plenty.
+    eventLog = malloc(EVENT_LOG_HEADER_SIZE + keyingLength);
+    if (eventLog == NULL) {
+        exit(1);
+    }
+    EventLogRecorderInit(&recorder, BenchmarkLogSink, 0);
+    for (tick = 0; tick < keyingLength; ++tick) {
+        if (keying[tick] & (BUTTON_EVENT_4DOWN | BUTTON_EVENT_4UP)) {
+            EventLogRecordEdge(&recorder, MORSE_CHANNEL_BTN4, tick * tickCounts,
+                    keying[tick] & BUTTON_EVENT_4DOWN);
+        }
+    }
+
+    // The edges are put on the software channel at their times, between polls of the keyer at
+    // 100Hz on the simulated core timer.
+    HostCoreTimerSet(0);
+    KeyCaptureInit(NULL);
+    start = BenchmarkNow();
+    for (repeat = 0; repeat < repeats; ++repeat) {
+        EventLogReader reader;
+        EventLogEdge edge;
+        KeyCaptureKeyer keyer;
+        uint32_t edgeTime = 0;
+        uint32_t now = 0;
+        HostCoreTimerSet(now);
+        KeyCaptureKeyerInit(&keyer, KEY_CAPTURE_CHANNEL_TONE);
+        EventLogReaderInit(&reader, eventLog, eventLogLength);
+        while (EventLogReadEdge(&reader, &edge) == SUCCESS) {
+            edgeTime += edge.delta;
+            while (edgeTime - now >= tickCounts) {
+                MorseEvent event;
+                now += tickCounts;
+                HostCoreTimerSet(now);
+                while ((event = KeyCaptureCheckEvents(&keyer)) != MORSE_EVENT_NONE) {
+                    check += event;
+                }
+                ticks++;
+            }
+            HostCoreTimerSet(edgeTime);
+            KeyCapturePutEdge(edgeTime, edge.pressed);
+        }
+    }
+    BenchmarkReport("EventLog replay (per 100Hz tick)", BenchmarkNow() - start, ticks);
+    printf("%-36s %10d bytes for %d ticks\n", "EventLog size", eventLogLength, keyingLength);
+    return check;
+}
+
+static uint32_t BenchmarkRenderCell(void)
+{
+    const long iterations = 1000000;
+    uint32_t check = 0;
+    uint64_t start;
+    long i;
+
+    start = BenchmarkNow();
+    for (i = 0; i < iterations; ++i) {
+        OledTextPutChar(0, i % OLED_CHARS_PER_LINE, 'A' + (i & 0x0F));
+        check += OledTextUpdate();
+    }
+    BenchmarkReport("OledTextUpdate (one dirty cell)", BenchmarkNow() - start, iterations);
+    return check;
+}
+
+static uint32_t BenchmarkRenderScreen(void)
+{
+    const long iterations = 100000;
+    uint32_t check = 0;
+    uint64_t start;
+    long i;
+    int line;
+
+    for (line = 0; line < OLED_NUM_LINES; ++line) {
+        OledTextSetLine(line, BENCHMARK_TEXT);
+    }
+    start = BenchmarkNow();
+    for (i = 0; i < iterations; ++i) {
+        // Flipping the inversion of every cell makes all of them dirty.
+        for (line = 0; line < OLED_NUM_LINES; ++line) {
+            OledTextSetInverted(line, 0, OLED_CHARS_PER_LINE, i & 1);
+        }
+        check += OledTextUpdate();
+    }
+    BenchmarkReport("OledTextUpdate (whole screen)", BenchmarkNow() - start, iterations);
+    return check;
+}
+
+static uint32_t BenchmarkRenderViewport(void)
+{
+    const int repeats = 20;
+    const char *text = BENCHMARK_TEXT " ";
+    uint32_t check = 0;
+    long operations = 0;
+    uint64_t start;
+    int repeat;
+    int i;
+
+    ViewportInit(0, OLED_NUM_LINES);
+    start = BenchmarkNow();
+    for (repeat = 0; repeat < repeats * BENCHMARK_TEXT_REPEATS; ++repeat) {
+        for (i = 0; text[i] != '\0'; ++i) {
+            ViewportPutChar(text[i]);
+            check += OledTextUpdate();
+        }
+        operations += i;
+    }
+    BenchmarkReport("Viewport text (per char shown)", BenchmarkNow() - start, operations);
+    return check;
+}
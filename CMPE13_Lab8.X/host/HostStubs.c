@@ -0,0 +1,76 @@
+#include <stdint.h>
+#include "HostStubs.h"
+#include "Ascii.h"
+#include "BOARD.h"
+#include "Buttons.h"
+#include "OledAsync.h"
+#include "OledDriver.h"
+#include "Trace.h"
+
+// Microchip libraries
+#include <plib.h>
+
+volatile unsigned int PORTD;
+volatile unsigned int PORTF;
+volatile unsigned int CNCONSET;
+volatile unsigned int CNENSET;
+volatile unsigned int SPI2BUF;
+volatile __SPI2STATbits_t SPI2STATbits = {1};
+
+// The real font is in the support library. Every glyph costs the same to draw, so blank ones
+// time the same.
+const uint8_t ascii[256][ASCII_FONT_WIDTH];
+uint8_t rgbOledBmp[OLED_DRIVER_BUFFER_SIZE];
+
+// The clocks the board runs at, as set up by BOARD_Init().
+#define HOST_SYSTEM_CLOCK 80000000
+#define HOST_PB_CLOCK (HOST_SYSTEM_CLOCK / 4)
+
+static uint8_t pendingEvents;
+static uint32_t coreTimer;
+
+void HostButtonsSetEvents(uint8_t events)
+{
+    pendingEvents = events;
+}
+
+void ButtonsInit(void)
+{
+    pendingEvents = BUTTON_EVENT_NONE;
+}
+
+uint8_t ButtonsCheckEvents(void)
+{
+    uint8_t events = pendingEvents;
+    pendingEvents = BUTTON_EVENT_NONE;
+    return events;
+}
+
+void TraceWrite(TraceId id, uint16_t value)
+{
+}
+
+void HostCoreTimerSet(uint32_t counts)
+{
+    coreTimer = counts;
+}
+
+unsigned int ReadCoreTimer(void)
+{
+    return coreTimer;
+}
+
+unsigned int BOARD_GetSysClock()
+{
+    return HOST_SYSTEM_CLOCK;
+}
+
+unsigned int BOARD_GetPBClock()
+{
+    return HOST_PB_CLOCK;
+}
+
+int OledAsyncIsBusy(void)
+{
+    return FALSE;
+}
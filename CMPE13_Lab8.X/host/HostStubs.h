@@ -0,0 +1,29 @@
+#ifndef HOST_STUBS_H
+#define HOST_STUBS_H
+
+/**
+ * @file
+ *
+ * This file declares the host-side stand-ins for the parts of the board support library that the
+ * portable modules call. Buttons are simulated: ButtonsCheckEvents() returns whatever events were
+ * last set with HostButtonsSetEvents(), once, and then BUTTON_EVENT_NONE until they're set again.
+ * The OLED has a frame buffer and a blank font, and its SPI transfers complete immediately, so
+ * rendering is timed without the wait for the display. Trace records are discarded. The core timer
+ * stands still unless it is set with HostCoreTimerSet(), and the clocks are those of the board.
+ */
+
+#include <stdint.h>
+
+/**
+ * Sets the button events returned by the next call to ButtonsCheckEvents().
+ * @param events A bitwise-ORing of the constants in the ButtonEventFlags enum.
+ */
+void HostButtonsSetEvents(uint8_t events);
+
+/**
+ * Sets what ReadCoreTimer() returns from now on.
+ * @param counts The core timer, which counts at half of BOARD_GetSysClock() on the board.
+ */
+void HostCoreTimerSet(uint32_t counts);
+
+#endif // HOST_STUBS_H
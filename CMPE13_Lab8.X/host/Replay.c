@@ -0,0 +1,211 @@
+/**
+ * @file
+ *
+ * Plays an EventLog recorded on the board back through a KeyCaptureKeyer and MorseTiming, the same
+ * way lab8 decodes the hand key and the audio input, as fast as the host runs, and prints the text
+ * it decodes. The recorded edges are put at their recorded times on a simulated core timer, which
+ * is otherwise stepped at 100Hz like the board's tick so the letter and word gaps end on time. The
+ * log can be the raw capture of the serial port: anything before the first log header is skipped.
+ *
+ * Usage: replay [-c channel] log
+ *   -c channel  The button the operator keyed on, from 2 to 4, or 5 for the audio input. Defaults
+ *               to 4.
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "BOARD.h"
+#include "EventLog.h"
+#include "KeyCapture.h"
+#include "Morse.h"
+#include "MorseTiming.h"
+#include "ToneDetect.h"
+#include "HostStubs.h"
+
+static uint8_t *ReplayReadFile(const char *path, long *size);
+static long ReplayFindHeader(const uint8_t *data, long size);
+static void ReplayDecode(KeyCaptureKeyer *keyer, MorseDecoder *decoder);
+
+// Whether a word has ended since the last letter was printed, so that no space trails the text.
+static int wordEnded;
+
+int main(int argc, char **argv)
+{
+    MorseChannel channel = MORSE_CHANNEL_BTN4;
+    const char *path = NULL;
+    EventLogReader reader;
+    EventLogEdge edge;
+    KeyCaptureKeyer keyer;
+    MorseTiming timing;
+    MorseDecoder decoder;
+    struct timespec start;
+    struct timespec end;
+    uint32_t tickCounts = BOARD_GetSysClock() / 2 / MORSE_TICKS_PER_SECOND;
+    uint32_t edgeTime = 0;
+    uint32_t now = 0;
+    uint8_t *data;
+    long edges = 0;
+    long ticks = 0;
+    long size;
+    long header;
+    int result;
+    int i;
+
+    for (i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "-c") == 0 && i + 1 < argc) {
+            int button = atoi(argv[++i]);
+            if (button < 2 || button > KEY_CAPTURE_NUM_CHANNELS) {
+                fprintf(stderr, "replay: no channel %s\n", argv[i]);
+                return 2;
+            }
+            channel = button - 1;
+        } else if (path == NULL) {
+            path = argv[i];
+        } else {
+            path = NULL;
+            break;
+        }
+    }
+    if (path == NULL) {
+        fprintf(stderr, "usage: replay [-c channel] log\n");
+        return 2;
+    }
+
+    data = ReplayReadFile(path, &size);
+    if (data == NULL) {
+        perror(path);
+        return 1;
+    }
+    header = ReplayFindHeader(data, size);
+    if (header < 0 || EventLogReaderInit(&reader, &data[header], size - header) != SUCCESS) {
+        fprintf(stderr, "replay: %s has no event log\n", path);
+        return 1;
+    }
+
+    // The edges of the chosen channel are put on the software channel, which times them exactly
+    // like a button's without reading any pins.
+    HostCoreTimerSet(now);
+    KeyCaptureInit(NULL);
+    KeyCaptureKeyerInit(&keyer, KEY_CAPTURE_CHANNEL_TONE);
+    if (channel == KEY_CAPTURE_CHANNEL_TONE) {
+        MorseTimingInit(&timing, TONE_DETECT_INITIAL_UNIT_US, KEY_CAPTURE_TICKS_PER_SECOND);
+    } else {
+        MorseTimingInit(&timing, MORSE_EVENT_LENGTH_DOWN_DOT *
+                (KEY_CAPTURE_TICKS_PER_SECOND / MORSE_TICKS_PER_SECOND),
+                KEY_CAPTURE_TICKS_PER_SECOND);
+    }
+    KeyCaptureKeyerSetTiming(&keyer, &timing);
+    MorseDecoderInit(&decoder, MORSE_CHANNEL_BTN4);
+    MorseDecoderSetTolerant(&decoder, TRUE);
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    while ((result = EventLogReadEdge(&reader, &edge)) == SUCCESS) {
+        edgeTime += edge.delta;
+        if (edge.channel != channel) {
+            continue;
+        }
+        while (edgeTime - now >= tickCounts) {
+            now += tickCounts;
+            HostCoreTimerSet(now);
+            ReplayDecode(&keyer, &decoder);
+            ticks++;
+        }
+        HostCoreTimerSet(edgeTime);
+        KeyCapturePutEdge(edgeTime, edge.pressed);
+        edges++;
+    }
+
+    // The log may stop before the gap after the last letter was long enough to end it.
+    while (!KeyCaptureKeyerIsIdle(&keyer)) {
+        now += tickCounts;
+        HostCoreTimerSet(now);
+        ReplayDecode(&keyer, &decoder);
+        ticks++;
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    putchar('\n');
+
+    fprintf(stderr, "replay: %ld edges (%.1fs of keying) in %.3fs, %u WPM%s\n", edges,
+            (double) ticks / MORSE_TICKS_PER_SECOND,
+            (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9,
+            MorseTimingGetWpm(&timing), result == SIZE_ERROR ? ", log cut off" : "");
+    free(data);
+    return 0;
+}
+
+/**
+ * Reads a whole file into a buffer that must be free()d, or returns NULL.
+ */
+static uint8_t *ReplayReadFile(const char *path, long *size)
+{
+    FILE *file = fopen(path, "rb");
+    uint8_t *data = NULL;
+    long capacity = 0;
+    long length = 0;
+    size_t count;
+
+    if (file == NULL) {
+        return NULL;
+    }
+    do {
+        if (length == capacity) {
+            uint8_t *bigger;
+            capacity = capacity ? capacity * 2 : 4096;
+            bigger = realloc(data, capacity);
+            if (bigger == NULL) {
+                free(data);
+                fclose(file);
+                return NULL;
+            }
+            data = bigger;
+        }
+        count = fread(&data[length], 1, capacity - length, file);
+        length += count;
+    } while (count > 0);
+    fclose(file);
+    *size = length;
+    return data;
+}
+
+/**
+ * Returns where the first log header starts in `data`, or -1 if there is none.
+ */
+static long ReplayFindHeader(const uint8_t *data, long size)
+{
+    long i;
+    for (i = 0; i + EVENT_LOG_HEADER_SIZE <= size; ++i) {
+        if (memcmp(&data[i], EVENT_LOG_MAGIC, EVENT_LOG_HEADER_SIZE - 1) == 0 &&
+                data[i + EVENT_LOG_HEADER_SIZE - 1] == EVENT_LOG_VERSION) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+/**
+ * Decodes and prints every event the keyer has ready.
+ */
+static void ReplayDecode(KeyCaptureKeyer *keyer, MorseDecoder *decoder)
+{
+    MorseEvent event;
+    while ((event = KeyCaptureCheckEvents(keyer)) != MORSE_EVENT_NONE) {
+        if (event == MORSE_EVENT_DOT) {
+            MorseDecoderDecode(decoder, MORSE_CHAR_DOT);
+        } else if (event == MORSE_EVENT_DASH) {
+            MorseDecoderDecode(decoder, MORSE_CHAR_DASH);
+        } else if (event == MORSE_EVENT_INTER_LETTER) {
+            char letter = MorseDecoderDecode(decoder, MORSE_CHAR_END_OF_CHAR);
+            if (wordEnded) {
+                putchar(' ');
+                wordEnded = FALSE;
+            }
+            putchar(letter != STANDARD_ERROR ? letter : '*');
+        } else if (event == MORSE_EVENT_INTER_WORD) {
+            MorseDecoderDecode(decoder, MORSE_CHAR_DECODE_RESET);
+            wordEnded = TRUE;
+        }
+    }
+}
@@ -0,0 +1,60 @@
+/**
+ * @file
+ *
+ * Feeds press sequences that have tripped up MorseTiming's DOT/DASH clustering through it at the
+ * board's 100Hz tick, and checks that every press leaves a usable unit and DASH threshold behind.
+ * Exits with 0 if every sequence passes and 1 otherwise.
+ *
+ * Usage: timingcheck
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include "Morse.h"
+#include "MorseTiming.h"
+
+static int CheckSequence(const char *name, const uint32_t *presses, int count);
+
+int main(void)
+{
+    // Presses this short put the first split at the shortest press.
+    static const uint32_t shortPresses[] = {1, 2};
+    // The second pass moves the split down onto the shortest press.
+    static const uint32_t driftingPresses[] = {2, 3, 3, 3, 3, 3, 3, 4};
+    // Nothing is ever at or above a split above zero.
+    static const uint32_t zeroPresses[] = {0, 0, 0};
+    int failures = 0;
+
+    failures += CheckSequence("1 and 2 ticks", shortPresses, 2);
+    failures += CheckSequence("2, 3 x6 and 4 ticks", driftingPresses, 8);
+    failures += CheckSequence("0 ticks", zeroPresses, 3);
+
+    if (failures > 0) {
+        printf("%d check(s) failed\n", failures);
+        return 1;
+    }
+    printf("All timing checks passed\n");
+    return 0;
+}
+
+// Adds the presses one at a time and returns how many of them left the thresholds unusable.
+static int CheckSequence(const char *name, const uint32_t *presses, int count)
+{
+    MorseTiming timing;
+    int failures = 0;
+    int i;
+
+    MorseTimingInit(&timing, MORSE_EVENT_LENGTH_DOWN_DOT, MORSE_TICKS_PER_SECOND);
+    for (i = 0; i < count; ++i) {
+        MorseTimingAddPress(&timing, presses[i]);
+        if (timing.unit == 0 || timing.dashThreshold <= timing.unit ||
+                timing.letterThreshold == 0 || timing.wordThreshold <= timing.letterThreshold) {
+            printf("%s: press %d left unit %lu, dash threshold %lu\n", name, i + 1,
+                    (unsigned long) timing.unit, (unsigned long) timing.dashThreshold);
+            failures++;
+        }
+    }
+    printf("%s: unit %lu, dash threshold %lu, %u WPM\n", name, (unsigned long) timing.unit,
+            (unsigned long) timing.dashThreshold, (unsigned) MorseTimingGetWpm(&timing));
+    return failures;
+}
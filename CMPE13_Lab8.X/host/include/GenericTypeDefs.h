@@ -0,0 +1,17 @@
+#ifndef GENERIC_TYPE_DEFS_H
+#define GENERIC_TYPE_DEFS_H
+
+/**
+ * @file
+ *
+ * The parts of Microchip's GenericTypeDefs.h that the portable modules use, for the host build.
+ */
+
+#include <stddef.h>
+
+typedef enum {
+    FALSE = 0,
+    TRUE
+} BOOL;
+
+#endif // GENERIC_TYPE_DEFS_H
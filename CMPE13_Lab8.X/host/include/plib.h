@@ -0,0 +1,46 @@
+#ifndef PLIB_H
+#define PLIB_H
+
+/**
+ * @file
+ *
+ * Stands in for the Microchip peripheral library in the host build. Pins don't exist on the host,
+ * so setting and clearing them does nothing.
+ */
+
+#define IOPORT_E 4
+#define IOPORT_F 5
+#define IOPORT_G 6
+
+#define BIT_0 (1 << 0)
+#define BIT_4 (1 << 4)
+#define BIT_5 (1 << 5)
+#define BIT_6 (1 << 6)
+#define BIT_9 (1 << 9)
+
+#define PORTSetBits(port, bits) ((void) (port), (void) (bits))
+#define PORTClearBits(port, bits) ((void) (port), (void) (bits))
+
+// Interrupts never happen on the host, so setting them up and masking them does nothing, and an
+// interrupt handler is just a function.
+#define INT_CN 0
+#define INT_CHANGE_NOTICE_VECTOR 0
+#define INT_DISABLED 0
+#define INT_ENABLED 1
+#define INT_PRIORITY_LEVEL_5 5
+#define INT_SUB_PRIORITY_LEVEL_0 0
+
+#define INTEnable(source, enable) ((void) (source), (void) (enable))
+#define INTClearFlag(source) ((void) (source))
+#define INTSetVectorPriority(vector, priority) ((void) (vector), (void) (priority))
+#define INTSetVectorSubPriority(vector, priority) ((void) (vector), (void) (priority))
+#define INTDisableInterrupts() 0u
+#define INTRestoreInterrupts(status) ((void) (status))
+#define __ISR(vector, priority)
+
+/**
+ * Returns the simulated core timer, which only moves when set with HostCoreTimerSet().
+ */
+unsigned int ReadCoreTimer(void);
+
+#endif // PLIB_H
@@ -0,0 +1,23 @@
+#ifndef XC_H
+#define XC_H
+
+/**
+ * @file
+ *
+ * Stands in for the XC32 device header in the host build. Only the registers that the modules
+ * built for the host name are declared. The SPI2 receive-buffer-full flag always reads as set, so
+ * every SPI transfer completes immediately.
+ */
+
+typedef struct {
+    unsigned int SPIRBF : 1;
+} __SPI2STATbits_t;
+
+extern volatile unsigned int PORTD;
+extern volatile unsigned int PORTF;
+extern volatile unsigned int CNCONSET;
+extern volatile unsigned int CNENSET;
+extern volatile unsigned int SPI2BUF;
+extern volatile __SPI2STATbits_t SPI2STATbits;
+
+#endif // XC_H
@@ -1,11 +1,27 @@
 // **** Include libraries here ****
 // Standard C libraries
-
+#include <stdio.h>
 
 //CMPE13 Support Library
 #include "BOARD.h"
+#include "Buttons.h"
+#include "Dictionary.h"
+#include "EventLog.h"
+#include "KeyCapture.h"
 #include "Morse.h"
+#include "MorseEncoder.h"
+#include "MorseTiming.h"
 #include "Oled.h"
+#include "OledText.h"
+#include "Power.h"
+#include "Profile.h"
+#include "Ring.h"
+#include "StackWatch.h"
+#include "TextLine.h"
+#include "ToneDetect.h"
+#include "Trace.h"
+#include "Uart.h"
+#include "Viewport.h"
 
 // Microchip libraries
 #include <xc.h>
@@ -19,30 +35,160 @@
 // unit testing the Morse event checker.
 #define BUTTON4_STATE_FLAG (1 << 7)
 
+// The number of events that can be waiting for the main loop. Must be a power of two.
+#define EVENT_QUEUE_SIZE 16
+
+// A short press of BTN1, up to this many 100Hz ticks, accepts the offered word completion, and a
+// longer one shows or hides the telemetry page. Both are queued by the timer interrupt and handled
+// by the decode task along with the MorseEvents.
+#define ACCEPT_PRESS_MAX_TICKS 50
+#define EVENT_ACCEPT_COMPLETION (MORSE_EVENT_INTER_WORD + 1)
+#define EVENT_TOGGLE_TELEMETRY (MORSE_EVENT_INTER_WORD + 2)
+
+// While nothing needs the 100Hz tick Timer2 only runs this often, to notice BTN1 being pressed.
+// BTN1 is on RF1, which has no change-notice input, so nothing else would wake the unit for it.
+#define TICK_RATE 100
+#define TICK_IDLE_RATE 20
+
+// How many times per second the telemetry page is updated while it is shown.
+#define TELEMETRY_REFRESH_RATE 2
+
+// The most times per second the screen is redrawn. Every change made in between is sent together
+// by the next frame.
+#define RENDER_FRAME_RATE 25
+
+// How many bytes of serial input are handled at a time.
+#define SERIAL_BLOCK_SIZE 32
+
+// Sending this over the serial port dumps the profiling statistics, and this clears them.
+#define SERIAL_PROFILE_DUMP '?'
+#define SERIAL_PROFILE_CLEAR '!'
+
+// Sending these start or stop streaming an EventLog of the key edges or Trace.h records of the
+// key edges and events out of the serial port. Neither can be told apart from text, so only one
+// of them is sent at a time, and the decoded text and profile dumps are held back while either is.
+#define SERIAL_LOG_TOGGLE 'L'
+#define SERIAL_TRACE_TOGGLE 'X'
+
+// Sending this starts or stops decoding the audio input. It is off at first, since sampling wakes
+// the core every 125us and noise on an unconnected input would be decoded as letters.
+#define SERIAL_TONE_TOGGLE 'T'
+
+// Sending this starts or stops sending BEACON_TEXT over and over on LD1. The encoder is timed by
+// its own interrupt, so decoding carries on while it sends.
+#define SERIAL_BEACON_TOGGLE 'B'
+#define BEACON_TEXT "CQ CQ DE CMPE13 K"
+#define BEACON_WPM 15
+
+// The decoded text scrolls through the top lines of the OLED, with the last line showing the DOTs
+// and DASHes of the letter currently being keyed. While the audio input is on, the line above that
+// shows the latest text heard on it instead of being part of the scrolling text.
+#define TEXT_FIRST_LINE 0
+#define TEXT_LINE_COUNT (OLED_NUM_LINES - 1)
+#define SYMBOL_LINE (OLED_NUM_LINES - 1)
+#define TONE_LINE (SYMBOL_LINE - 1)
+
 // **** Declare any data types here ****
+// A task run by the main loop, which returns TRUE if it did any work.
+typedef int (*Task)(void);
 
 // **** Define any module-level, global, or external variables here ****
-MorseEvent mevent;
-int mflag = 0;
-char display[100];
-char *clet = " ";
-char *csymb = " ";
-char *templet = " ";
-char *tempsymb = " ";
+// Events found by the timer interrupt are queued here until the decode task handles them.
+static uint8_t eventQueueBuffer[EVENT_QUEUE_SIZE];
+static Ring eventQueue = RING_INITIALIZER(eventQueueBuffer);
+// The operator keys on BTN4, which is timed from its edges with the timing adapting to their
+// speed. The decoder only tracks the letter being decoded from the resulting events, and guesses
+// the nearest letter for a mistyped one instead of dropping it.
+static KeyCaptureKeyer keyer;
+static MorseTiming keyerTiming;
+static MorseDecoder decoder;
+
+// Off-air CW heard on the audio input is timed and decoded separately from the hand key, since it
+// is usually sent at a different speed and shouldn't break into a letter being keyed. The text
+// scrolls to the left along its own line.
+static KeyCaptureKeyer toneKeyer;
+static MorseTiming toneTiming;
+static MorseDecoder toneDecoder;
+static TextLine toneText;
+
+// Morse code can also be streamed in over the serial port, as DOTs and DASHes with letters ended
+// by a ' ' or '#' and words by a second ' '. It is decoded separately from the keyer and the text
+// is sent back.
+static MorseDecoder serialDecoder;
+static uint8_t serialLetterStarted;
+static uint8_t serialLetterInvalid;
+
+// The edges of every key are logged by KeyCapture while recording, each with its own timestamp.
+static EventLogRecorder recorder;
+static uint8_t recording;
+
+// The DOTs and DASHes of the letter currently being keyed.
+static TextLine symbols;
+
+// The letters of the word currently being keyed and the completion offered for it, if any. A word
+// longer than any in the dictionary just stops being tracked. Once a completion is accepted the
+// space after it has already been added, so the INTER_WORD that follows is skipped.
+static char word[DICTIONARY_MAX_WORD_LENGTH];
+static uint8_t wordLength;
+static const char *completion;
+static uint8_t completionAccepted;
+
+// Whether the text has changed since the last frame, and when that frame was sent, in core timer
+// counts.
+static uint8_t screenDirty;
+static uint32_t lastFrame;
+static uint32_t frameCounts;
+
+// While the telemetry page is shown it covers the whole screen, and the decoded text is kept by
+// the viewport until the page is hidden again. The page is redrawn every `telemetryCounts`, but
+// only the digits that changed are sent.
+static uint8_t telemetryShown;
+static uint32_t lastTelemetry;
+static uint32_t telemetryCounts;
+
+// How many times the 100Hz tick was still running when the next one was due.
+static volatile uint32_t tickOverruns;
+
+// Whether Timer2 has been slowed to TICK_IDLE_RATE, how many ticks BTN1 has been held for and
+// whether it is down, as last debounced. The ticks only count while the timer runs at full rate,
+// so they are started over whenever it is sped up again.
+static volatile uint8_t ticksSlow;
+static volatile uint16_t btn1Ticks;
+static volatile uint8_t btn1Down;
 // **** Declare any function prototypes here ****
-void updateScreen();
-void clrSymb();
-void clrLet();
-void appendBot();
-void appendTop();
+int decodeTask(void);
+int renderTask(void);
+int profileTask(void);
+void handleEvent(uint8_t mevent);
+void handleToneEvent(uint8_t mevent);
+void toggleTone(void);
+void toggleTelemetry(void);
+void drawTelemetry(void);
+void drawLine(int line, const TextLine *text);
+void addToWord(char letter);
+void acceptCompletion(void);
+int decodeSerial(void);
+void decodeSerialChar(uint8_t c);
+int serialIsText(void);
+void sendText(uint8_t c);
+void startTicks(void);
+void slowTicksIfIdle(void);
+
+// The tasks of the main loop, highest priority first. Every pass starts over from the first task
+// once any of them did some work, so new input is always decoded before the screen is drawn and a
+// frame never delays an event by more than the one frame already being sent.
+static const Task tasks[] = {decodeTask, decodeSerial, renderTask, profileTask};
+#define TASK_COUNT ((int) (sizeof (tasks) / sizeof (tasks[0])))
 
 int main(void)
 {
+    // Done first so that none of the stack that is used later is still unmarked.
+    StackWatchInit();
     BOARD_Init();
 
     // Configure Timer 2 using PBCLK as input. We configure it using a 1:16 prescalar, so each timer
     // tick is actually at F_PB / 16 Hz, so setting PR2 to F_PB / 16 / 100 yields a .01s timer.
-    OpenTimer2(T2_ON | T2_SOURCE_INT | T2_PS_1_16, BOARD_GetPBClock() / 16 / 100);
+    OpenTimer2(T2_ON | T2_SOURCE_INT | T2_PS_1_16, BOARD_GetPBClock() / 16 / TICK_RATE);
 
     // Set up the timer interrupt with a medium priority of 4.
     INTClearFlag(INT_T2);
@@ -53,22 +199,51 @@ int main(void)
     /******************************************************************************
      * Your code goes in between this comment and the following one with asterisks.
      *****************************************************************************/
+    // Hold off the timer interrupt until everything it uses has been initialized.
+    INTEnable(INT_T2, INT_DISABLED);
     OledInit();
+    OledTextInit();
     MorseInit();
+    MorseEncoderInit();
+    MorseDecoderInit(&decoder, MORSE_CHANNEL_BTN4);
+    MorseDecoderSetTolerant(&decoder, TRUE);
+    MorseDecoderInit(&serialDecoder, MORSE_CHANNEL_BTN1);
+    UartInit();
+    ProfileInit();
+    PowerInit();
+    KeyCaptureInit(startTicks);
+    KeyCaptureKeyerInit(&keyer, MORSE_CHANNEL_BTN4);
+    MorseTimingInit(&keyerTiming,
+            MORSE_EVENT_LENGTH_DOWN_DOT * (KEY_CAPTURE_TICKS_PER_SECOND / MORSE_TICKS_PER_SECOND),
+            KEY_CAPTURE_TICKS_PER_SECOND);
+    KeyCaptureKeyerSetTiming(&keyer, &keyerTiming);
+    KeyCaptureKeyerInit(&toneKeyer, KEY_CAPTURE_CHANNEL_TONE);
+    MorseTimingInit(&toneTiming, TONE_DETECT_INITIAL_UNIT_US, KEY_CAPTURE_TICKS_PER_SECOND);
+    KeyCaptureKeyerSetTiming(&toneKeyer, &toneTiming);
+    MorseDecoderInit(&toneDecoder, MORSE_CHANNEL_BTN4);
+    MorseDecoderSetTolerant(&toneDecoder, TRUE);
+    ViewportInit(TEXT_FIRST_LINE, TEXT_LINE_COUNT);
+    TextLineClear(&symbols);
+
+    // The core timer counts at half the system clock. The first frame is due right away.
+    frameCounts = BOARD_GetSysClock() / 2 / RENDER_FRAME_RATE;
+    lastFrame = ReadCoreTimer() - frameCounts;
+    telemetryCounts = BOARD_GetSysClock() / 2 / TELEMETRY_REFRESH_RATE;
+    INTEnable(INT_T2, INT_ENABLED);
     while (1) {
-        if (mflag) {
-            if (mevent == MORSE_EVENT_DOT) {
-                MorseDecode(MORSE_CHAR_DOT);
-            } else if (mevent == MORSE_EVENT_DASH) {
-                MorseDecode(MORSE_CHAR_DASH);
-            } else if (mevent == MORSE_EVENT_INTER_LETTER) {
-                templet[0] = MorseDecode(MORSE_CHAR_END_OF_CHAR);
-            } else if (mevent == MORSE_EVENT_INTER_WORD) {
-                MorseDecode(MORSE_CHAR_DECODE_RESET);
+        int i;
+        for (i = 0; i < TASK_COUNT; ++i) {
+            if (tasks[i]()) {
+                break;
             }
-            updateScreen();
-            mevent = 0;
-            mflag = 0;
+        }
+
+        // Nothing is left to do until the next interrupt. Once the keyers are idle and the last
+        // frame is sent even the 100Hz timer isn't needed until the next edge or press of BTN1,
+        // which speeds it up again.
+        if (i == TASK_COUNT) {
+            slowTicksIfIdle();
+            PowerIdle();
         }
     }
 
@@ -85,49 +260,376 @@ void __ISR(_TIMER_2_VECTOR, IPL4AUTO) TimerInterrupt100Hz(void)
     IFS0CLR = 1 << 8;
 
     //******** Put your code here *************//
-    mevent = MorseCheckEvents();
-    if (mevent != MORSE_EVENT_NONE) {
-        mflag = 1;
+    // Only the buttons are polled and the BTN1 presses queued here. The keyers are read and the
+    // events decoded by the main loop, which this interrupt wakes up every tick.
+    uint8_t buttonEvents;
+    if (ticksSlow) {
+        // Only BTN1 is watched until something needs the full rate again.
+        if (BUTTON_STATES() & BUTTON_STATE_1) {
+            startTicks();
+        }
+        return;
+    }
+    PROFILE_BEGIN(PROFILE_PROBE_TICK);
+
+    PROFILE_BEGIN(PROFILE_PROBE_BUTTONS);
+    buttonEvents = ButtonsCheckEvents();
+    PROFILE_END(PROFILE_PROBE_BUTTONS);
+
+    btn1Ticks++;
+    if (buttonEvents & BUTTON_EVENT_1DOWN) {
+        btn1Ticks = 0;
+        btn1Down = TRUE;
+    } else if (buttonEvents & BUTTON_EVENT_1UP) {
+        btn1Down = FALSE;
+        RingPut(&eventQueue, (btn1Ticks <= ACCEPT_PRESS_MAX_TICKS) ?
+                EVENT_ACCEPT_COMPLETION : EVENT_TOGGLE_TELEMETRY);
+    }
+
+    // The flag is set again if the next tick came due while this one ran.
+    if (INTGetFlag(INT_T2)) {
+        tickOverruns++;
+    }
+    PROFILE_END(PROFILE_PROBE_TICK);
+}
+
+/**
+ * Handles every event from the keyers and the timer interrupt that is ready, which only updates
+ * the text in RAM. Edges are timestamped as they happen, so how late this runs never changes how
+ * they are timed.
+ */
+int decodeTask(void)
+{
+    int handled = FALSE;
+    while (1) {
+        uint8_t mevent;
+        uint8_t toneEvent;
+        PROFILE_BEGIN(PROFILE_PROBE_KEYER);
+        mevent = KeyCaptureCheckEvents(&keyer);
+        toneEvent = KeyCaptureCheckEvents(&toneKeyer);
+        PROFILE_END(PROFILE_PROBE_KEYER);
+        if (toneEvent != MORSE_EVENT_NONE) {
+            handleToneEvent(toneEvent);
+            handled = TRUE;
+        }
+        if (mevent == MORSE_EVENT_NONE && RingGet(&eventQueue, &mevent) != SUCCESS) {
+            return handled;
+        }
+        handleEvent(mevent);
+        handled = TRUE;
+    }
+}
+
+/**
+ * Sends everything that changed to the OLED in a single frame, once the previous frame is at
+ * least 1 / RENDER_FRAME_RATE old.
+ */
+int renderTask(void)
+{
+    uint32_t now = ReadCoreTimer();
+    if (telemetryShown) {
+        // Events don't change the telemetry page, which is redrawn at its own, slower rate.
+        if (now - lastTelemetry < telemetryCounts) {
+            return FALSE;
+        }
+        lastTelemetry = now;
+    } else if (!screenDirty || now - lastFrame < frameCounts) {
+        return FALSE;
+    }
+    lastFrame = now;
+    screenDirty = FALSE;
+
+    PROFILE_BEGIN(PROFILE_PROBE_DRAW);
+    if (telemetryShown) {
+        drawTelemetry();
+    } else if (TextLineLength(&symbols) == 0 && completion != NULL) {
+        // Between letters the symbol line offers the completion instead.
+        TextLine hint;
+        const char *c;
+        TextLineClear(&hint);
+        TextLineAppend(&hint, '>');
+        TextLineAppend(&hint, ' ');
+        for (c = completion; *c != '\0'; ++c) {
+            TextLineAppend(&hint, *c);
+        }
+        drawLine(SYMBOL_LINE, &hint);
+    } else {
+        drawLine(SYMBOL_LINE, &symbols);
+    }
+    if (!telemetryShown && ToneDetectIsRunning()) {
+        drawLine(TONE_LINE, &toneText);
+    }
+    PROFILE_END(PROFILE_PROBE_DRAW);
+
+    PROFILE_BEGIN(PROFILE_PROBE_OLED_UPDATE);
+    OledTextUpdate();
+    PROFILE_END(PROFILE_PROBE_OLED_UPDATE);
+    return TRUE;
+}
+
+/**
+ * Queues what fits of a requested profile dump. The rest has to wait for room in the UART, which
+ * interrupts once there is some, so this never counts as work.
+ */
+int profileTask(void)
+{
+    if (serialIsText()) {
+        ProfileSendDump();
+    }
+    return FALSE;
+}
+
+void handleEvent(uint8_t mevent)
+{
+    if (mevent == EVENT_ACCEPT_COMPLETION) {
+        acceptCompletion();
+    } else if (mevent == EVENT_TOGGLE_TELEMETRY) {
+        toggleTelemetry();
+    } else if (mevent == MORSE_EVENT_DOT) {
+        MorseDecoderDecode(&decoder, MORSE_CHAR_DOT);
+        TextLineAppend(&symbols, MORSE_CHAR_DOT);
+    } else if (mevent == MORSE_EVENT_DASH) {
+        MorseDecoderDecode(&decoder, MORSE_CHAR_DASH);
+        TextLineAppend(&symbols, MORSE_CHAR_DASH);
+    } else if (mevent == MORSE_EVENT_INTER_LETTER) {
+        char letter = MorseDecoderDecode(&decoder, MORSE_CHAR_END_OF_CHAR);
+        TextLineClear(&symbols);
+        if (letter != STANDARD_ERROR) {
+            ViewportPutChar(letter);
+            addToWord(letter);
+        }
+    } else if (mevent == MORSE_EVENT_INTER_WORD) {
+        MorseDecoderDecode(&decoder, MORSE_CHAR_DECODE_RESET);
+        TextLineClear(&symbols);
+        if (!completionAccepted) {
+            ViewportPutChar(' ');
+        }
+        wordLength = 0;
+        completion = NULL;
+        completionAccepted = FALSE;
     }
+    screenDirty = TRUE;
 }
 
-void updateScreen()
+void handleToneEvent(uint8_t mevent)
 {
     if (mevent == MORSE_EVENT_DOT) {
-        tempsymb = ".";
-        appendBot();
+        MorseDecoderDecode(&toneDecoder, MORSE_CHAR_DOT);
     } else if (mevent == MORSE_EVENT_DASH) {
-        tempsymb = "-";
-        appendBot();
+        MorseDecoderDecode(&toneDecoder, MORSE_CHAR_DASH);
     } else if (mevent == MORSE_EVENT_INTER_LETTER) {
-        clrSymb();
-        appendTop();
+        char letter = MorseDecoderDecode(&toneDecoder, MORSE_CHAR_END_OF_CHAR);
+        if (letter != STANDARD_ERROR) {
+            TextLineAppend(&toneText, letter);
+        }
     } else if (mevent == MORSE_EVENT_INTER_WORD) {
-        clrSymb();
-        appendTop();
+        MorseDecoderDecode(&toneDecoder, MORSE_CHAR_DECODE_RESET);
+        TextLineAppend(&toneText, ' ');
+    }
+    screenDirty = TRUE;
+}
+
+/**
+ * Starts or stops decoding the audio input. The scrolling text gives up its last line to the
+ * heard text while it is on and gets it back after.
+ */
+void toggleTone(void)
+{
+    if (ToneDetectIsRunning()) {
+        ToneDetectStop();
+        ViewportResize(TEXT_LINE_COUNT);
+    } else if (ToneDetectInit(TONE_DETECT_DEFAULT_PITCH) == SUCCESS) {
+        MorseDecoderDecode(&toneDecoder, MORSE_CHAR_DECODE_RESET);
+        TextLineClear(&toneText);
+        ViewportResize(TEXT_LINE_COUNT - 1);
+    }
+    screenDirty = TRUE;
+}
+
+void toggleTelemetry(void)
+{
+    int line;
+    telemetryShown = !telemetryShown;
+    if (telemetryShown) {
+        ViewportSetVisible(FALSE);
+
+        // Make the first page due right away, measuring the idle time from now on.
+        lastTelemetry = ReadCoreTimer() - telemetryCounts;
+        PowerGetIdlePermille();
+    } else {
+        for (line = 0; line < OLED_NUM_LINES; ++line) {
+            OledTextSetInverted(line, 0, OLED_CHARS_PER_LINE, FALSE);
+        }
+        ViewportSetVisible(TRUE);
+    }
+}
+
+/**
+ * Writes every counter to the telemetry page, one line each for the stack, dropped events, time and
+ * speed. A line showing something that went wrong is inverted so it stands out.
+ */
+void drawTelemetry(void)
+{
+    char string[OLED_CHARS_PER_LINE + 1];
+    unsigned long queueDrops = eventQueue.overflows;
+    unsigned long keyDrops = KeyCaptureGetOverflows();
+    unsigned long uartDrops = UartGetRxOverflows() + UartGetTxOverflows();
+    unsigned long overruns = tickOverruns;
+    uint16_t idle = PowerGetIdlePermille();
+
+    snprintf(string, sizeof (string), "STACK %lu/%lu", (unsigned long) StackWatchGetUsed(),
+            (unsigned long) StackWatchGetSize());
+    OledTextSetLine(0, string);
+    snprintf(string, sizeof (string), "DROP Q%lu K%lu U%lu", queueDrops, keyDrops, uartDrops);
+    OledTextSetLine(1, string);
+    OledTextSetInverted(1, 0, OLED_CHARS_PER_LINE, queueDrops + keyDrops + uartDrops > 0);
+    snprintf(string, sizeof (string), "OVERRUN %lu IDLE %u.%u%%", overruns, idle / 10, idle % 10);
+    OledTextSetLine(2, string);
+    OledTextSetInverted(2, 0, OLED_CHARS_PER_LINE, overruns > 0);
+    snprintf(string, sizeof (string), "WPM KEY %u TONE %u", MorseTimingGetWpm(&keyerTiming),
+            MorseTimingGetWpm(&toneTiming));
+    OledTextSetLine(3, string);
+}
+
+void addToWord(char letter)
+{
+    completionAccepted = FALSE;
+    if (wordLength < DICTIONARY_MAX_WORD_LENGTH) {
+        word[wordLength] = letter;
+        wordLength++;
+        completion = DictionaryComplete(word, wordLength);
+    } else {
+        completion = NULL;
     }
-    sprintf(display, "%s\n\n\n%s", clet, csymb);
-    //    printf("\n%s", display);
-    OledDrawString(display);
-    OledUpdate();
 }
 
-void clrSymb(char* str)
+void acceptCompletion(void)
 {
-    memset(csymb, 0, sizeof (csymb));
+    const char *rest;
+    if (completion == NULL) {
+        return;
+    }
+    for (rest = completion + wordLength; *rest != '\0'; ++rest) {
+        ViewportPutChar(*rest);
+    }
+    ViewportPutChar(' ');
+    wordLength = 0;
+    completion = NULL;
+    completionAccepted = TRUE;
 }
 
-void clrLet(char* str)
+void drawLine(int line, const TextLine *text)
 {
-    memset(clet, 0, sizeof (clet));
+    char string[TEXT_LINE_LENGTH + 1];
+    TextLineCopy(text, string);
+    OledTextSetLine(line, string);
 }
 
-void appendBot()
+int decodeSerial(void)
 {
-    sprintf(csymb, "%s%s", csymb, tempsymb);
+    uint8_t block[SERIAL_BLOCK_SIZE];
+    int count = UartRead(block, sizeof (block));
+    int i;
+    for (i = 0; i < count; ++i) {
+        decodeSerialChar(block[i]);
+    }
+    return count > 0;
+}
+
+void decodeSerialChar(uint8_t c)
+{
+    if (c == MORSE_CHAR_DOT || c == MORSE_CHAR_DASH) {
+        if (MorseDecoderDecode(&serialDecoder, c) == STANDARD_ERROR) {
+            serialLetterInvalid = TRUE;
+        }
+        serialLetterStarted = TRUE;
+    } else if (c == ' ' || c == MORSE_CHAR_END_OF_CHAR || c == '\r' || c == '\n') {
+        if (serialLetterStarted) {
+            char letter = MorseDecoderDecode(&serialDecoder, MORSE_CHAR_END_OF_CHAR);
+            if (serialLetterInvalid || letter == STANDARD_ERROR) {
+                letter = '*';
+            }
+            sendText(letter);
+            serialLetterStarted = FALSE;
+            serialLetterInvalid = FALSE;
+        } else if (c == ' ') {
+            sendText(' ');
+        }
+        if (c == '\n') {
+            sendText('\n');
+        }
+    } else if (c == SERIAL_PROFILE_DUMP) {
+        ProfileRequestDump();
+    } else if (c == SERIAL_PROFILE_CLEAR) {
+        ProfileInit();
+    } else if (c == SERIAL_LOG_TOGGLE) {
+        if (recording) {
+            KeyCaptureSetRecorder(NULL);
+            recording = FALSE;
+        } else if (!TraceIsEnabled() &&
+                EventLogRecorderInit(&recorder, UartWrite, ReadCoreTimer()) == SUCCESS) {
+            KeyCaptureSetRecorder(&recorder);
+            recording = TRUE;
+        }
+    } else if (c == SERIAL_TRACE_TOGGLE) {
+        if (TraceIsEnabled()) {
+            TraceSetEnabled(FALSE);
+        } else if (!recording) {
+            TraceSetEnabled(TRUE);
+        }
+    } else if (c == SERIAL_TONE_TOGGLE) {
+        toggleTone();
+    } else if (c == SERIAL_BEACON_TOGGLE) {
+        if (MorseEncoderIsBusy()) {
+            MorseEncoderStop();
+        } else {
+            MorseEncoderSend(BEACON_TEXT, BEACON_WPM, TRUE);
+        }
+    }
 }
 
-void appendTop()
+/**
+ * Returns whether text can be sent over the serial port, which is only while nothing binary is.
+ */
+int serialIsText(void)
 {
-    sprintf(clet, "%s%s", clet, templet);
-}
\ No newline at end of file
+    return !recording && !TraceIsEnabled();
+}
+
+void sendText(uint8_t c)
+{
+    if (serialIsText()) {
+        UartPutChar(c);
+    }
+}
+
+void startTicks(void)
+{
+    if (ticksSlow) {
+        T2CONCLR = _T2CON_ON_MASK;
+        TMR2 = 0;
+        PR2 = BOARD_GetPBClock() / 16 / TICK_RATE;
+        INTClearFlag(INT_T2);
+        ticksSlow = FALSE;
+        btn1Ticks = 0;
+        T2CONSET = _T2CON_ON_MASK;
+    }
+}
+
+void slowTicksIfIdle(void)
+{
+    // An edge between the check and slowing the timer would have its speed-up undone. BTN1 must be
+    // up, both on the pin and as debounced, or its release would be missed.
+    unsigned int status = INTDisableInterrupts();
+    if (!ticksSlow && RingCount(&eventQueue) == 0 && KeyCaptureKeyerIsIdle(&keyer) &&
+            KeyCaptureKeyerIsIdle(&toneKeyer) && !screenDirty && !telemetryShown &&
+            !btn1Down && !(BUTTON_STATES() & BUTTON_STATE_1)) {
+        T2CONCLR = _T2CON_ON_MASK;
+        TMR2 = 0;
+        PR2 = BOARD_GetPBClock() / 16 / TICK_IDLE_RATE;
+        INTClearFlag(INT_T2);
+        ticksSlow = TRUE;
+        T2CONSET = _T2CON_ON_MASK;
+    }
+    INTRestoreInterrupts(status);
+}
@@ -45,17 +45,17 @@ OBJECTDIR=build/${CND_CONF}/${IMAGE_TYPE}
 DISTDIR=dist/${CND_CONF}/${IMAGE_TYPE}
 
 # Source Files Quoted if spaced
-SOURCEFILES_QUOTED_IF_SPACED=BOARD.c Tree.c Morse.c lab8.c
+SOURCEFILES_QUOTED_IF_SPACED=BOARD.c Tree.c Morse.c lab8.c Ring.c OledText.c OledAsync.c TextLine.c Viewport.c MorseTiming.c KeyCapture.c Power.c Uart.c Trace.c MorseEncoder.c Dictionary.c Profile.c ToneDetect.c EventLog.c StackWatch.c
 
 # Object Files Quoted if spaced
-OBJECTFILES_QUOTED_IF_SPACED=${OBJECTDIR}/BOARD.o ${OBJECTDIR}/Tree.o ${OBJECTDIR}/Morse.o ${OBJECTDIR}/lab8.o
-POSSIBLE_DEPFILES=${OBJECTDIR}/BOARD.o.d ${OBJECTDIR}/Tree.o.d ${OBJECTDIR}/Morse.o.d ${OBJECTDIR}/lab8.o.d
+OBJECTFILES_QUOTED_IF_SPACED=${OBJECTDIR}/BOARD.o ${OBJECTDIR}/Tree.o ${OBJECTDIR}/Morse.o ${OBJECTDIR}/lab8.o ${OBJECTDIR}/Ring.o ${OBJECTDIR}/OledText.o ${OBJECTDIR}/OledAsync.o ${OBJECTDIR}/TextLine.o ${OBJECTDIR}/Viewport.o ${OBJECTDIR}/MorseTiming.o ${OBJECTDIR}/KeyCapture.o ${OBJECTDIR}/Power.o ${OBJECTDIR}/Uart.o ${OBJECTDIR}/Trace.o ${OBJECTDIR}/MorseEncoder.o ${OBJECTDIR}/Dictionary.o ${OBJECTDIR}/Profile.o ${OBJECTDIR}/ToneDetect.o ${OBJECTDIR}/EventLog.o ${OBJECTDIR}/StackWatch.o
+POSSIBLE_DEPFILES=${OBJECTDIR}/BOARD.o.d ${OBJECTDIR}/Tree.o.d ${OBJECTDIR}/Morse.o.d ${OBJECTDIR}/lab8.o.d ${OBJECTDIR}/Ring.o.d ${OBJECTDIR}/OledText.o.d ${OBJECTDIR}/OledAsync.o.d ${OBJECTDIR}/TextLine.o.d ${OBJECTDIR}/Viewport.o.d ${OBJECTDIR}/MorseTiming.o.d ${OBJECTDIR}/KeyCapture.o.d ${OBJECTDIR}/Power.o.d ${OBJECTDIR}/Uart.o.d ${OBJECTDIR}/Trace.o.d ${OBJECTDIR}/MorseEncoder.o.d ${OBJECTDIR}/Dictionary.o.d ${OBJECTDIR}/Profile.o.d ${OBJECTDIR}/ToneDetect.o.d ${OBJECTDIR}/EventLog.o.d ${OBJECTDIR}/StackWatch.o.d
 
 # Object Files
-OBJECTFILES=${OBJECTDIR}/BOARD.o ${OBJECTDIR}/Tree.o ${OBJECTDIR}/Morse.o ${OBJECTDIR}/lab8.o
+OBJECTFILES=${OBJECTDIR}/BOARD.o ${OBJECTDIR}/Tree.o ${OBJECTDIR}/Morse.o ${OBJECTDIR}/lab8.o ${OBJECTDIR}/Ring.o ${OBJECTDIR}/OledText.o ${OBJECTDIR}/OledAsync.o ${OBJECTDIR}/TextLine.o ${OBJECTDIR}/Viewport.o ${OBJECTDIR}/MorseTiming.o ${OBJECTDIR}/KeyCapture.o ${OBJECTDIR}/Power.o ${OBJECTDIR}/Uart.o ${OBJECTDIR}/Trace.o ${OBJECTDIR}/MorseEncoder.o ${OBJECTDIR}/Dictionary.o ${OBJECTDIR}/Profile.o ${OBJECTDIR}/ToneDetect.o ${OBJECTDIR}/EventLog.o ${OBJECTDIR}/StackWatch.o
 
 # Source Files
-SOURCEFILES=BOARD.c Tree.c Morse.c lab8.c
+SOURCEFILES=BOARD.c Tree.c Morse.c lab8.c Ring.c OledText.c OledAsync.c TextLine.c Viewport.c MorseTiming.c KeyCapture.c Power.c Uart.c Trace.c MorseEncoder.c Dictionary.c Profile.c ToneDetect.c EventLog.c StackWatch.c
 
 
 CFLAGS=
@@ -118,6 +118,102 @@ ${OBJECTDIR}/lab8.o: lab8.c  nbproject/Makefile-${CND_CONF}.mk
 	@${RM} ${OBJECTDIR}/lab8.o 
 	@${FIXDEPS} "${OBJECTDIR}/lab8.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG -D__MPLAB_DEBUGGER_PK3=1 -fframe-base-loclist  -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -Wall -MMD -MF "${OBJECTDIR}/lab8.o.d" -o ${OBJECTDIR}/lab8.o lab8.c     
 	
+${OBJECTDIR}/StackWatch.o: StackWatch.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/StackWatch.o.d 
+	@${RM} ${OBJECTDIR}/StackWatch.o 
+	@${FIXDEPS} "${OBJECTDIR}/StackWatch.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG -D__MPLAB_DEBUGGER_PK3=1 -fframe-base-loclist  -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -Wall -MMD -MF "${OBJECTDIR}/StackWatch.o.d" -o ${OBJECTDIR}/StackWatch.o StackWatch.c     
+	
+${OBJECTDIR}/EventLog.o: EventLog.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/EventLog.o.d 
+	@${RM} ${OBJECTDIR}/EventLog.o 
+	@${FIXDEPS} "${OBJECTDIR}/EventLog.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG -D__MPLAB_DEBUGGER_PK3=1 -fframe-base-loclist  -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -Wall -MMD -MF "${OBJECTDIR}/EventLog.o.d" -o ${OBJECTDIR}/EventLog.o EventLog.c     
+	
+${OBJECTDIR}/ToneDetect.o: ToneDetect.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/ToneDetect.o.d 
+	@${RM} ${OBJECTDIR}/ToneDetect.o 
+	@${FIXDEPS} "${OBJECTDIR}/ToneDetect.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG -D__MPLAB_DEBUGGER_PK3=1 -fframe-base-loclist  -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -Wall -MMD -MF "${OBJECTDIR}/ToneDetect.o.d" -o ${OBJECTDIR}/ToneDetect.o ToneDetect.c     
+	
+${OBJECTDIR}/Profile.o: Profile.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/Profile.o.d 
+	@${RM} ${OBJECTDIR}/Profile.o 
+	@${FIXDEPS} "${OBJECTDIR}/Profile.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG -D__MPLAB_DEBUGGER_PK3=1 -fframe-base-loclist  -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -Wall -MMD -MF "${OBJECTDIR}/Profile.o.d" -o ${OBJECTDIR}/Profile.o Profile.c     
+	
+${OBJECTDIR}/Dictionary.o: Dictionary.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/Dictionary.o.d 
+	@${RM} ${OBJECTDIR}/Dictionary.o 
+	@${FIXDEPS} "${OBJECTDIR}/Dictionary.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG -D__MPLAB_DEBUGGER_PK3=1 -fframe-base-loclist  -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -Wall -MMD -MF "${OBJECTDIR}/Dictionary.o.d" -o ${OBJECTDIR}/Dictionary.o Dictionary.c     
+	
+${OBJECTDIR}/MorseEncoder.o: MorseEncoder.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/MorseEncoder.o.d 
+	@${RM} ${OBJECTDIR}/MorseEncoder.o 
+	@${FIXDEPS} "${OBJECTDIR}/MorseEncoder.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG -D__MPLAB_DEBUGGER_PK3=1 -fframe-base-loclist  -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -Wall -MMD -MF "${OBJECTDIR}/MorseEncoder.o.d" -o ${OBJECTDIR}/MorseEncoder.o MorseEncoder.c     
+	
+${OBJECTDIR}/Trace.o: Trace.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/Trace.o.d 
+	@${RM} ${OBJECTDIR}/Trace.o 
+	@${FIXDEPS} "${OBJECTDIR}/Trace.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG -D__MPLAB_DEBUGGER_PK3=1 -fframe-base-loclist  -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -Wall -MMD -MF "${OBJECTDIR}/Trace.o.d" -o ${OBJECTDIR}/Trace.o Trace.c     
+	
+${OBJECTDIR}/Uart.o: Uart.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/Uart.o.d 
+	@${RM} ${OBJECTDIR}/Uart.o 
+	@${FIXDEPS} "${OBJECTDIR}/Uart.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG -D__MPLAB_DEBUGGER_PK3=1 -fframe-base-loclist  -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -Wall -MMD -MF "${OBJECTDIR}/Uart.o.d" -o ${OBJECTDIR}/Uart.o Uart.c     
+	
+${OBJECTDIR}/Power.o: Power.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/Power.o.d 
+	@${RM} ${OBJECTDIR}/Power.o 
+	@${FIXDEPS} "${OBJECTDIR}/Power.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG -D__MPLAB_DEBUGGER_PK3=1 -fframe-base-loclist  -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -Wall -MMD -MF "${OBJECTDIR}/Power.o.d" -o ${OBJECTDIR}/Power.o Power.c     
+	
+${OBJECTDIR}/KeyCapture.o: KeyCapture.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/KeyCapture.o.d 
+	@${RM} ${OBJECTDIR}/KeyCapture.o 
+	@${FIXDEPS} "${OBJECTDIR}/KeyCapture.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG -D__MPLAB_DEBUGGER_PK3=1 -fframe-base-loclist  -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -Wall -MMD -MF "${OBJECTDIR}/KeyCapture.o.d" -o ${OBJECTDIR}/KeyCapture.o KeyCapture.c     
+	
+${OBJECTDIR}/MorseTiming.o: MorseTiming.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/MorseTiming.o.d 
+	@${RM} ${OBJECTDIR}/MorseTiming.o 
+	@${FIXDEPS} "${OBJECTDIR}/MorseTiming.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG -D__MPLAB_DEBUGGER_PK3=1 -fframe-base-loclist  -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -Wall -MMD -MF "${OBJECTDIR}/MorseTiming.o.d" -o ${OBJECTDIR}/MorseTiming.o MorseTiming.c     
+	
+${OBJECTDIR}/Viewport.o: Viewport.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/Viewport.o.d 
+	@${RM} ${OBJECTDIR}/Viewport.o 
+	@${FIXDEPS} "${OBJECTDIR}/Viewport.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG -D__MPLAB_DEBUGGER_PK3=1 -fframe-base-loclist  -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -Wall -MMD -MF "${OBJECTDIR}/Viewport.o.d" -o ${OBJECTDIR}/Viewport.o Viewport.c     
+	
+${OBJECTDIR}/TextLine.o: TextLine.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/TextLine.o.d 
+	@${RM} ${OBJECTDIR}/TextLine.o 
+	@${FIXDEPS} "${OBJECTDIR}/TextLine.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG -D__MPLAB_DEBUGGER_PK3=1 -fframe-base-loclist  -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -Wall -MMD -MF "${OBJECTDIR}/TextLine.o.d" -o ${OBJECTDIR}/TextLine.o TextLine.c     
+	
+${OBJECTDIR}/OledAsync.o: OledAsync.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/OledAsync.o.d 
+	@${RM} ${OBJECTDIR}/OledAsync.o 
+	@${FIXDEPS} "${OBJECTDIR}/OledAsync.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG -D__MPLAB_DEBUGGER_PK3=1 -fframe-base-loclist  -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -Wall -MMD -MF "${OBJECTDIR}/OledAsync.o.d" -o ${OBJECTDIR}/OledAsync.o OledAsync.c     
+	
+${OBJECTDIR}/OledText.o: OledText.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/OledText.o.d 
+	@${RM} ${OBJECTDIR}/OledText.o 
+	@${FIXDEPS} "${OBJECTDIR}/OledText.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG -D__MPLAB_DEBUGGER_PK3=1 -fframe-base-loclist  -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -Wall -MMD -MF "${OBJECTDIR}/OledText.o.d" -o ${OBJECTDIR}/OledText.o OledText.c     
+	
+${OBJECTDIR}/Ring.o: Ring.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/Ring.o.d 
+	@${RM} ${OBJECTDIR}/Ring.o 
+	@${FIXDEPS} "${OBJECTDIR}/Ring.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG -D__MPLAB_DEBUGGER_PK3=1 -fframe-base-loclist  -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -Wall -MMD -MF "${OBJECTDIR}/Ring.o.d" -o ${OBJECTDIR}/Ring.o Ring.c     
+	
 else
 ${OBJECTDIR}/BOARD.o: BOARD.c  nbproject/Makefile-${CND_CONF}.mk
 	@${MKDIR} "${OBJECTDIR}" 
@@ -143,6 +239,102 @@ ${OBJECTDIR}/lab8.o: lab8.c  nbproject/Makefile-${CND_CONF}.mk
 	@${RM} ${OBJECTDIR}/lab8.o 
 	@${FIXDEPS} "${OBJECTDIR}/lab8.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -Wall -MMD -MF "${OBJECTDIR}/lab8.o.d" -o ${OBJECTDIR}/lab8.o lab8.c     
 	
+${OBJECTDIR}/StackWatch.o: StackWatch.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/StackWatch.o.d 
+	@${RM} ${OBJECTDIR}/StackWatch.o 
+	@${FIXDEPS} "${OBJECTDIR}/StackWatch.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -Wall -MMD -MF "${OBJECTDIR}/StackWatch.o.d" -o ${OBJECTDIR}/StackWatch.o StackWatch.c     
+	
+${OBJECTDIR}/EventLog.o: EventLog.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/EventLog.o.d 
+	@${RM} ${OBJECTDIR}/EventLog.o 
+	@${FIXDEPS} "${OBJECTDIR}/EventLog.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -Wall -MMD -MF "${OBJECTDIR}/EventLog.o.d" -o ${OBJECTDIR}/EventLog.o EventLog.c     
+	
+${OBJECTDIR}/ToneDetect.o: ToneDetect.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/ToneDetect.o.d 
+	@${RM} ${OBJECTDIR}/ToneDetect.o 
+	@${FIXDEPS} "${OBJECTDIR}/ToneDetect.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -Wall -MMD -MF "${OBJECTDIR}/ToneDetect.o.d" -o ${OBJECTDIR}/ToneDetect.o ToneDetect.c     
+	
+${OBJECTDIR}/Profile.o: Profile.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/Profile.o.d 
+	@${RM} ${OBJECTDIR}/Profile.o 
+	@${FIXDEPS} "${OBJECTDIR}/Profile.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -Wall -MMD -MF "${OBJECTDIR}/Profile.o.d" -o ${OBJECTDIR}/Profile.o Profile.c     
+	
+${OBJECTDIR}/Dictionary.o: Dictionary.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/Dictionary.o.d 
+	@${RM} ${OBJECTDIR}/Dictionary.o 
+	@${FIXDEPS} "${OBJECTDIR}/Dictionary.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -Wall -MMD -MF "${OBJECTDIR}/Dictionary.o.d" -o ${OBJECTDIR}/Dictionary.o Dictionary.c     
+	
+${OBJECTDIR}/MorseEncoder.o: MorseEncoder.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/MorseEncoder.o.d 
+	@${RM} ${OBJECTDIR}/MorseEncoder.o 
+	@${FIXDEPS} "${OBJECTDIR}/MorseEncoder.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -Wall -MMD -MF "${OBJECTDIR}/MorseEncoder.o.d" -o ${OBJECTDIR}/MorseEncoder.o MorseEncoder.c     
+	
+${OBJECTDIR}/Trace.o: Trace.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/Trace.o.d 
+	@${RM} ${OBJECTDIR}/Trace.o 
+	@${FIXDEPS} "${OBJECTDIR}/Trace.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -Wall -MMD -MF "${OBJECTDIR}/Trace.o.d" -o ${OBJECTDIR}/Trace.o Trace.c     
+	
+${OBJECTDIR}/Uart.o: Uart.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/Uart.o.d 
+	@${RM} ${OBJECTDIR}/Uart.o 
+	@${FIXDEPS} "${OBJECTDIR}/Uart.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -Wall -MMD -MF "${OBJECTDIR}/Uart.o.d" -o ${OBJECTDIR}/Uart.o Uart.c     
+	
+${OBJECTDIR}/Power.o: Power.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/Power.o.d 
+	@${RM} ${OBJECTDIR}/Power.o 
+	@${FIXDEPS} "${OBJECTDIR}/Power.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -Wall -MMD -MF "${OBJECTDIR}/Power.o.d" -o ${OBJECTDIR}/Power.o Power.c     
+	
+${OBJECTDIR}/KeyCapture.o: KeyCapture.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/KeyCapture.o.d 
+	@${RM} ${OBJECTDIR}/KeyCapture.o 
+	@${FIXDEPS} "${OBJECTDIR}/KeyCapture.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -Wall -MMD -MF "${OBJECTDIR}/KeyCapture.o.d" -o ${OBJECTDIR}/KeyCapture.o KeyCapture.c     
+	
+${OBJECTDIR}/MorseTiming.o: MorseTiming.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/MorseTiming.o.d 
+	@${RM} ${OBJECTDIR}/MorseTiming.o 
+	@${FIXDEPS} "${OBJECTDIR}/MorseTiming.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -Wall -MMD -MF "${OBJECTDIR}/MorseTiming.o.d" -o ${OBJECTDIR}/MorseTiming.o MorseTiming.c     
+	
+${OBJECTDIR}/Viewport.o: Viewport.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/Viewport.o.d 
+	@${RM} ${OBJECTDIR}/Viewport.o 
+	@${FIXDEPS} "${OBJECTDIR}/Viewport.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -Wall -MMD -MF "${OBJECTDIR}/Viewport.o.d" -o ${OBJECTDIR}/Viewport.o Viewport.c     
+	
+${OBJECTDIR}/TextLine.o: TextLine.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/TextLine.o.d 
+	@${RM} ${OBJECTDIR}/TextLine.o 
+	@${FIXDEPS} "${OBJECTDIR}/TextLine.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -Wall -MMD -MF "${OBJECTDIR}/TextLine.o.d" -o ${OBJECTDIR}/TextLine.o TextLine.c     
+	
+${OBJECTDIR}/OledAsync.o: OledAsync.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/OledAsync.o.d 
+	@${RM} ${OBJECTDIR}/OledAsync.o 
+	@${FIXDEPS} "${OBJECTDIR}/OledAsync.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -Wall -MMD -MF "${OBJECTDIR}/OledAsync.o.d" -o ${OBJECTDIR}/OledAsync.o OledAsync.c     
+	
+${OBJECTDIR}/OledText.o: OledText.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/OledText.o.d 
+	@${RM} ${OBJECTDIR}/OledText.o 
+	@${FIXDEPS} "${OBJECTDIR}/OledText.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -Wall -MMD -MF "${OBJECTDIR}/OledText.o.d" -o ${OBJECTDIR}/OledText.o OledText.c     
+	
+${OBJECTDIR}/Ring.o: Ring.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/Ring.o.d 
+	@${RM} ${OBJECTDIR}/Ring.o 
+	@${FIXDEPS} "${OBJECTDIR}/Ring.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -Wall -MMD -MF "${OBJECTDIR}/Ring.o.d" -o ${OBJECTDIR}/Ring.o Ring.c     
+	
 endif
 
 # ------------------------------------------------------------------------------------